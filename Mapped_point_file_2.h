@@ -0,0 +1,305 @@
+#ifndef CGAL_MAPPED_POINT_FILE_2_H
+#define CGAL_MAPPED_POINT_FILE_2_H
+
+#include <cstddef>
+#include <cstring>
+#include <iterator>
+#include <string>
+
+#if defined( _WIN32)
+#  ifndef NOMINMAX
+#    define NOMINMAX
+#  endif
+#  include <windows.h>
+#else
+#  include <sys/mman.h>
+#  include <sys/stat.h>
+#  include <fcntl.h>
+#  include <unistd.h>
+#endif
+
+namespace CGAL {
+
+// Memory mapped binary point files
+// ================================
+// A file of 2D points in binary form, mapped into memory read-only and
+// exposed as a random access range of Point. The records follow an
+// optional header of header_bytes bytes; every record starts with the x
+// and y coordinate as native endian float64 or int32 values and records
+// are stride bytes apart (0: packed, i.e. 16 or 8 bytes). A trailing
+// partial record is ignored.
+//
+// Nothing is read before a point is dereferenced, and dereferencing
+// builds the Point from the mapped bytes, so the range can be handed to
+// the solvers' iterator constructors without an intermediate copy.
+template < class Point_ >
+class Mapped_point_file_2;
+
+template < class Point_ >
+class Mapped_point_file_2 {
+  public:
+    // types
+    typedef           Point_                            Point;
+
+    enum Coordinate_type { FLOAT64, INT32 };
+
+    // layout of the file
+    struct Format {
+        Coordinate_type  coordinates;
+        std::size_t      header_bytes;
+        std::size_t      stride;
+
+        Format( Coordinate_type type = FLOAT64, std::size_t header = 0,
+                std::size_t record_stride = 0)
+            : coordinates( type), header_bytes( header), stride( record_stride)
+        { }
+    };
+
+    // what Iterator::operator-> returns: the point by value, so that
+    // it->x() works although there is no Point to point to
+    class Arrow {
+      public:
+        explicit Arrow( const Point& p) : point( p) { }
+        const Point* operator->( ) const { return( &point); }
+
+      private:
+        Point point;
+    };
+
+    // random access iterator over the records; dereferencing returns the
+    // point by value
+    class Iterator {
+      public:
+        typedef std::random_access_iterator_tag  iterator_category;
+        typedef Point                            value_type;
+        typedef std::ptrdiff_t                   difference_type;
+        typedef Arrow                            pointer;
+        typedef Point                            reference;
+
+        Iterator( ) : file( 0), index( 0) { }
+        Iterator( const Mapped_point_file_2<Point_>* f, std::ptrdiff_t i)
+            : file( f), index( i) { }
+
+        Point operator*( ) const { return( file->point( index)); }
+        Arrow operator->( ) const { return( Arrow( file->point( index))); }
+        Point operator[]( difference_type n) const { return( file->point( index + n)); }
+
+        Iterator& operator++( )    { ++index; return( *this); }
+        Iterator& operator--( )    { --index; return( *this); }
+        Iterator  operator++( int) { Iterator i( *this); ++index; return( i); }
+        Iterator  operator--( int) { Iterator i( *this); --index; return( i); }
+        Iterator& operator+=( difference_type n) { index += n; return( *this); }
+        Iterator& operator-=( difference_type n) { index -= n; return( *this); }
+        Iterator  operator+( difference_type n) const { return( Iterator( file, index + n)); }
+        Iterator  operator-( difference_type n) const { return( Iterator( file, index - n)); }
+        difference_type operator-( const Iterator& i) const { return( index - i.index); }
+        friend Iterator operator+( difference_type n, const Iterator& i) { return( i + n); }
+
+        bool operator==( const Iterator& i) const { return( index == i.index); }
+        bool operator!=( const Iterator& i) const { return( index != i.index); }
+        bool operator< ( const Iterator& i) const { return( index <  i.index); }
+        bool operator> ( const Iterator& i) const { return( index >  i.index); }
+        bool operator<=( const Iterator& i) const { return( index <= i.index); }
+        bool operator>=( const Iterator& i) const { return( index >= i.index); }
+
+      private:
+        const Mapped_point_file_2<Point_>* file;
+        std::ptrdiff_t index;
+    };
+
+    typedef Iterator  Point_iterator;
+
+  private:
+    // private data members
+    Format       format;
+    const unsigned char* data;                  // first record
+    std::size_t  n_points;
+    std::size_t  stride;                        // bytes per record
+    void*        mapping;                       // mapped view
+    std::size_t  mapping_size;
+    std::string  message;                       // why open() failed
+#if defined( _WIN32)
+    HANDLE       file_handle, mapping_handle;
+#endif
+
+    // copying and assignment not allowed!
+    Mapped_point_file_2( const Mapped_point_file_2<Point_>&);
+    Mapped_point_file_2<Point_>& operator = ( const Mapped_point_file_2<Point_>&);
+
+// ============================================================================
+
+// Class implementation
+// ====================
+
+  public:
+    // Constructors and destructor
+    // ---------------------------
+    Mapped_point_file_2( )
+    {
+        reset();
+    }
+
+    Mapped_point_file_2( const std::string& path, const Format& file_format = Format())
+    {
+        reset();
+        open( path, file_format);
+    }
+
+    ~Mapped_point_file_2( )
+    {
+        close();
+    }
+
+    // map the file; returns false and leaves the range empty if it cannot
+    // be mapped, error() tells why
+    bool
+    open( const std::string& path, const Format& file_format = Format())
+    {
+        close();
+        message.clear();
+        format = file_format;
+        std::size_t record = format.coordinates == FLOAT64 ? 2 * sizeof( double)
+                                                           : 2 * sizeof( int);
+        stride = format.stride == 0 ? record : format.stride;
+        if ( stride < record)
+            return( fail( "stride smaller than a record"));
+
+#if defined( _WIN32)
+        file_handle = CreateFileA( path.c_str(), GENERIC_READ, FILE_SHARE_READ, 0,
+                                   OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, 0);
+        if ( file_handle == INVALID_HANDLE_VALUE)
+            return( fail( "cannot open " + path));
+        LARGE_INTEGER size;
+        if ( !GetFileSizeEx( file_handle, &size))
+            return( fail( "cannot stat " + path));
+        mapping_size = std::size_t( size.QuadPart);
+        if ( mapping_size > 0) {
+            mapping_handle = CreateFileMappingA( file_handle, 0, PAGE_READONLY, 0, 0, 0);
+            if ( mapping_handle == 0)
+                return( fail( "cannot map " + path));
+            mapping = MapViewOfFile( mapping_handle, FILE_MAP_READ, 0, 0, 0);
+            if ( mapping == 0)
+                return( fail( "cannot map " + path));
+        }
+#else
+        int fd = ::open( path.c_str(), O_RDONLY);
+        if ( fd < 0)
+            return( fail( "cannot open " + path));
+        struct stat status;
+        if ( fstat( fd, &status) != 0) {
+            ::close( fd);
+            return( fail( "cannot stat " + path));
+        }
+        mapping_size = std::size_t( status.st_size);
+        if ( mapping_size > 0) {
+            mapping = mmap( 0, mapping_size, PROT_READ, MAP_PRIVATE, fd, 0);
+            if ( mapping == MAP_FAILED) {
+                mapping = 0;
+                ::close( fd);
+                return( fail( "cannot map " + path));
+            }
+            // the records are read once, front to back
+            madvise( mapping, mapping_size, MADV_SEQUENTIAL);
+        }
+        ::close( fd);
+#endif
+
+        if ( mapping_size < format.header_bytes)
+            return( fail( "file shorter than its header"));
+        std::size_t body = mapping_size - format.header_bytes;
+        n_points = body < record ? 0 : ( body - record) / stride + 1;
+        data = static_cast< const unsigned char*>( mapping) + format.header_bytes;
+        return( true);
+    }
+
+    void
+    close( )
+    {
+#if defined( _WIN32)
+        if ( mapping)
+            UnmapViewOfFile( mapping);
+        if ( mapping_handle)
+            CloseHandle( mapping_handle);
+        if ( file_handle != INVALID_HANDLE_VALUE)
+            CloseHandle( file_handle);
+#else
+        if ( mapping)
+            munmap( mapping, mapping_size);
+#endif
+        reset();
+    }
+
+    // Access functions
+    // ----------------
+    bool               is_open( ) const { return( data != 0); }
+    const std::string& error( )   const { return( message); }
+    std::size_t        size( )    const { return( n_points); }
+    bool               empty( )   const { return( n_points == 0); }
+
+    Iterator begin( ) const { return( Iterator( this, 0)); }
+    Iterator end( )   const { return( Iterator( this, std::ptrdiff_t( n_points))); }
+    Point operator[]( std::size_t i) const { return( point( i)); }
+
+    // coordinates of record i; the records need not be aligned
+    double
+    x( std::size_t i) const
+    {
+        return( coordinate( data + i * stride));
+    }
+
+    double
+    y( std::size_t i) const
+    {
+        return( coordinate( data + i * stride +
+                            ( format.coordinates == FLOAT64 ? sizeof( double)
+                                                            : sizeof( int))));
+    }
+
+    Point
+    point( std::size_t i) const
+    {
+        return( Point( x( i), y( i)));
+    }
+
+  private:
+    double
+    coordinate( const unsigned char* bytes) const
+    {
+        if ( format.coordinates == FLOAT64) {
+            double d;
+            std::memcpy( &d, bytes, sizeof( double));
+            return( d);
+        }
+        int k;
+        std::memcpy( &k, bytes, sizeof( int));
+        return( double( k));
+    }
+
+    void
+    reset( )
+    {
+        data = 0;
+        n_points = 0;
+        stride = 0;
+        mapping = 0;
+        mapping_size = 0;
+#if defined( _WIN32)
+        file_handle = INVALID_HANDLE_VALUE;
+        mapping_handle = 0;
+#endif
+    }
+
+    bool
+    fail( const std::string& why)
+    {
+        close();
+        message = why;
+        return( false);
+    }
+};
+
+} //namespace CGAL
+
+#endif // CGAL_MAPPED_POINT_FILE_2_H
+
+// ===== EOF =================================================================
@@ -0,0 +1,579 @@
+#ifndef CGAL_MIN_ELLIPSE_2_KHACHIYAN_H
+#define CGAL_MIN_ELLIPSE_2_KHACHIYAN_H
+
+#include <CGAL/Optimisation/basic.h>
+#include <vector>
+#include <algorithm>
+#include <iterator>
+#include <cmath>
+#include <limits>
+#include <cstddef>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+namespace CGAL {
+
+// Approximate min ellipse
+// =======================
+// Kumar and Yildirim's core set algorithm for the minimum volume enclosing
+// ellipse, in double precision. Khachiyan's dual weights u live on a small
+// core set, which starts with the extreme points in two directions. The
+// weights are optimized on the core set by Todd and Yildirim's iteration
+// with away steps, then a scan over all points adds the point farthest
+// outside the weighted ellipse to the core set, until no point is.
+//
+// For weights u with center c = sum u_i p_i and scatter matrix
+// S = sum u_i (p_i - c)(p_i - c)^T, the ellipse (x-c)^T S^-1 (x-c) <= 2 has
+// at most the area of the minimum ellipse. The iteration stops once every
+// point satisfies (p-c)^T S^-1 (p-c) <= 2 (1+eps)^2. ellipse() is the
+// smallest scaled copy containing all points: it encloses the input, and
+// shrunk by the factor 1+eps about its center it is no larger than the
+// minimum ellipse. Containment is decided in double arithmetic, with a
+// relative margin of 1e-12 against rounding. If all points are on a line,
+// or so close to one that the scatter matrix is numerically singular, the
+// ellipse is the segment between the extreme points along the line,
+// widened by the largest distance of a point from it. If the weights do
+// not converge within max_iterations updates, the ellipse still contains
+// every point, but is_converged() is false and the area bound may not hold.
+//
+// Only double approximations of the points are stored; the support points
+// are the core set.
+template < class Traits_ >
+class Min_ellipse_2_khachiyan;
+
+template < class Traits_ >
+class Min_ellipse_2_khachiyan {
+  public:
+    // types
+    typedef           Traits_                           Traits;
+    typedef typename  Traits_::Point                    Point;
+    typedef typename  std::vector<Point>::const_iterator  Support_point_iterator;
+
+    // the ellipse (x - center)^T [ a b; b c] (x - center) <= 1, or for
+    // (numerically) collinear points the segment (or point) between the ends
+    class Ellipse {
+      public:
+        Ellipse( )
+            : cx( 0), cy( 0), m_a( 0), m_b( 0), m_c( 0), degenerate( true),
+              empty( true), x0( 0), y0( 0), x1( 0), y1( 0), width( 0)
+        { }
+
+        bool   is_empty( )      const { return( empty); }
+        bool   is_degenerate( ) const { return( degenerate); }
+        double center_x( )      const { return( cx); }
+        double center_y( )      const { return( cy); }
+        double a( )             const { return( m_a); }
+        double b( )             const { return( m_b); }
+        double c( )             const { return( m_c); }
+
+        double
+        area( ) const
+        {
+            if ( degenerate)
+                return( 0);
+            return( 3.14159265358979323846 / std::sqrt( m_a * m_c - m_b * m_b));
+        }
+
+        Bounded_side
+        bounded_side( double x, double y) const
+        {
+            if ( empty)
+                return( ON_UNBOUNDED_SIDE);
+            if ( degenerate) {
+                // on the segment [ (x0, y0), (x1, y1)]? The cross product is
+                // allowed to be off by width, the projection by rounding
+                double ux = x1 - x0, uy = y1 - y0, ex = x - x0, ey = y - y0;
+                double length = ux * ux + uy * uy;
+                if ( length == 0)
+                    return( ex == 0 && ey == 0 ? ON_BOUNDARY : ON_UNBOUNDED_SIDE);
+                double cross = ux * ey - uy * ex, dot = ux * ex + uy * ey;
+                double bound = 1e-12 * ( std::fabs( ux) + std::fabs( uy))
+                                     * ( std::fabs( ex) + std::fabs( ey));
+                if ( std::fabs( cross) > (std::max)( bound, width)
+                     || dot < -1e-12 * length || dot > ( 1 + 1e-12) * length)
+                    return( ON_UNBOUNDED_SIDE);
+                return( ON_BOUNDARY);
+            }
+            double dx = x - cx, dy = y - cy;
+            double r = m_a * dx * dx + 2 * m_b * dx * dy + m_c * dy * dy;
+            return( r < 1 ? ON_BOUNDED_SIDE
+                          : ( r == 1 ? ON_BOUNDARY : ON_UNBOUNDED_SIDE));
+        }
+
+        Bounded_side
+        bounded_side( const Point& p) const
+        {
+            return( bounded_side( CGAL::to_double( p.x()),
+                                  CGAL::to_double( p.y())));
+        }
+
+        bool
+        has_on_bounded_side( const Point& p) const
+        {
+            return( bounded_side( p) == ON_BOUNDED_SIDE);
+        }
+
+        bool
+        has_on_unbounded_side( const Point& p) const
+        {
+            return( bounded_side( p) == ON_UNBOUNDED_SIDE);
+        }
+
+      private:
+        friend class Min_ellipse_2_khachiyan< Traits_ >;
+
+        double cx, cy, m_a, m_b, m_c;
+        bool   degenerate, empty;
+        double x0, y0, x1, y1;                  // ends if degenerate
+        double width;                           // largest |cross| if degenerate
+    };
+
+  private:
+    // private data members
+    Traits       tco;                           // traits class object
+    double       eps;                           // tolerance
+    std::size_t  n_points;                      // number of points
+    std::vector< double>  point_x, point_y;     // double coordinates
+
+    std::vector< std::size_t>  core;            // indices of the core set
+    std::vector< double>       weight;          // weights of the core set
+    std::vector< Point>        support_points;  // the core set points
+    Ellipse      current_ellipse;
+
+    // center and inverse scatter matrix of the current weights
+    double       c_x, c_y, s_a, s_b, s_c;
+
+    std::size_t  n_scans;                       // scans over all points
+    std::size_t  n_iterations;                  // core set iterations
+    bool         converged;                     // core_limit met in time?
+
+    enum { max_iterations = 100000 };
+
+    // copying and assignment not allowed!
+    Min_ellipse_2_khachiyan( const Min_ellipse_2_khachiyan<Traits_>&);
+    Min_ellipse_2_khachiyan<Traits_>& operator = ( const Min_ellipse_2_khachiyan<Traits_>&);
+
+// ============================================================================
+
+// Class implementation
+// ====================
+
+  public:
+    // Access functions
+    // ----------------
+    inline
+    std::size_t
+    number_of_points( ) const
+    {
+        return( n_points);
+    }
+
+    // size of the core set
+    inline
+    int
+    number_of_support_points( ) const
+    {
+        return( int( support_points.size()));
+    }
+
+    inline
+    Support_point_iterator
+    support_points_begin( ) const
+    {
+        return( support_points.begin());
+    }
+
+    inline
+    Support_point_iterator
+    support_points_end( ) const
+    {
+        return( support_points.end());
+    }
+
+    inline
+    const Point&
+    support_point( int i) const
+    {
+        CGAL_optimisation_precondition( (i >= 0) &&
+                                        (i <  number_of_support_points()));
+        return( support_points[ i]);
+    }
+
+    // index into the input range of support point i
+    inline
+    std::size_t
+    support_point_index( int i) const
+    {
+        CGAL_optimisation_precondition( (i >= 0) &&
+                                        (i <  number_of_support_points()));
+        return( core[ i]);
+    }
+
+    inline
+    const Ellipse&
+    ellipse( ) const
+    {
+        return( current_ellipse);
+    }
+
+    inline
+    double
+    epsilon( ) const
+    {
+        return( eps);
+    }
+
+    // number of scans over all points and of weight updates on the core set
+    inline
+    std::size_t
+    number_of_scans( ) const
+    {
+        return( n_scans);
+    }
+
+    inline
+    std::size_t
+    number_of_iterations( ) const
+    {
+        return( n_iterations);
+    }
+
+    // false if the weights did not converge within max_iterations updates
+    inline
+    bool
+    is_converged( ) const
+    {
+        return( converged);
+    }
+
+    inline
+    const Traits&
+    traits( ) const
+    {
+        return( tco);
+    }
+
+  private:
+    // Private member functions
+    // ------------------------
+    // the scatter matrix is formed about the weighted center, so the
+    // coordinates need no normalization
+    template < class ForwardIterator >
+    void
+    load_points( ForwardIterator first, ForwardIterator last)
+    {
+        for ( ; first != last; ++first) {
+            point_x.push_back( CGAL::to_double( first->x()));
+            point_y.push_back( CGAL::to_double( first->y()));
+        }
+        n_points = point_x.size();
+    }
+
+    // index of the point maximizing dx * x + dy * y, the first one on ties
+    std::size_t
+    extreme_point( double dx, double dy) const
+    {
+        std::size_t i, best = 0;
+        double value = dx * point_x[ 0] + dy * point_y[ 0];
+        for ( i = 1; i < n_points; ++i) {
+            double v = dx * point_x[ i] + dy * point_y[ i];
+            if ( v > value) {
+                value = v;
+                best = i;
+            }
+        }
+        return( best);
+    }
+
+    void
+    add_to_core( std::size_t i)
+    {
+        if ( std::find( core.begin(), core.end(), i) == core.end()) {
+            core.push_back( i);
+            weight.push_back( 0);
+        }
+    }
+
+    // center and inverse scatter matrix of the weights; false if the
+    // scatter matrix is singular
+    bool
+    update_center( )
+    {
+        double x = 0, y = 0, xx = 0, xy = 0, yy = 0;
+        std::size_t j;
+        for ( j = 0; j < core.size(); ++j) {
+            x += weight[ j] * point_x[ core[ j]];
+            y += weight[ j] * point_y[ core[ j]];
+        }
+        for ( j = 0; j < core.size(); ++j) {
+            double dx = point_x[ core[ j]] - x, dy = point_y[ core[ j]] - y;
+            xx += weight[ j] * dx * dx;
+            xy += weight[ j] * dx * dy;
+            yy += weight[ j] * dy * dy;
+        }
+        double det = xx * yy - xy * xy;
+        if ( !( det > 0))
+            return( false);
+        c_x = x; c_y = y;
+        s_a = yy / det; s_b = -xy / det; s_c = xx / det;
+        return( true);
+    }
+
+    // (p-c)^T S^-1 (p-c) of points[ i]
+    inline
+    double
+    distance( std::size_t i) const
+    {
+        double dx = point_x[ i] - c_x, dy = point_y[ i] - c_y;
+        return( s_a * dx * dx + 2 * s_b * dx * dy + s_c * dy * dy);
+    }
+
+    // optimize the weights on the core set until every core point is
+    // within the given distance, or clear converged after max_iterations
+    // updates. The lifted points (p, 1) have q^T M^-1 q = distance + 1 and
+    // the lifted dimension is 3. False if the scatter matrix is singular.
+    bool
+    optimize_core( double limit)
+    {
+        const double n = 3;
+        for ( std::size_t it = 0; it < max_iterations; ++it) {
+            if ( !update_center())
+                return( false);
+
+            std::size_t j, up = 0, down = core.size();
+            double k_up = -HUGE_VAL, k_down = HUGE_VAL;
+            for ( j = 0; j < core.size(); ++j) {
+                double k = distance( core[ j]) + 1;
+                if ( k > k_up) { k_up = k; up = j; }
+                if ( weight[ j] > 0 && k < k_down) { k_down = k; down = j; }
+            }
+            if ( k_up - 1 <= limit)
+                return( true);
+            ++n_iterations;
+
+            // toward step on the farthest point, or away step from the
+            // nearest weighted point if that one is further off
+            if ( down == core.size() || k_up / n - 1 >= 1 - k_down / n) {
+                double beta = ( k_up - n) / ( n * ( k_up - 1));
+                for ( j = 0; j < core.size(); ++j)
+                    weight[ j] *= 1 - beta;
+                weight[ up] += beta;
+            } else {
+                double beta = ( n - k_down) / ( n * ( k_down - 1));
+                if ( weight[ down] < 1)
+                    beta = (std::min)( beta, weight[ down] / ( 1 - weight[ down]));
+                for ( j = 0; j < core.size(); ++j)
+                    weight[ j] *= 1 + beta;
+                weight[ down] -= beta;
+                if ( weight[ down] < 0)
+                    weight[ down] = 0;
+            }
+        }
+        converged = false;
+        return( update_center());
+    }
+
+    // the farthest point from the current center and its distance
+    std::size_t
+    farthest_point( double& max_distance) const
+    {
+        std::size_t best = 0;
+        double best_distance = -HUGE_VAL;
+
+#ifdef _OPENMP
+        #pragma omp parallel if ( n_points > 100000)
+#endif
+        {
+            std::size_t local_best = 0;
+            double local_distance = -HUGE_VAL;
+            long i;
+#ifdef _OPENMP
+            #pragma omp for schedule( static) nowait
+#endif
+            for ( i = 0; i < long( n_points); ++i) {
+                double d = distance( i);
+                if ( d > local_distance) {
+                    local_distance = d;
+                    local_best = i;
+                }
+            }
+#ifdef _OPENMP
+            #pragma omp critical
+#endif
+            if ( local_distance > best_distance ||
+                 ( local_distance == best_distance && local_best < best)) {
+                best_distance = local_distance;
+                best = local_best;
+            }
+        }
+        max_distance = best_distance;
+        return( best);
+    }
+
+    // the ellipse is the segment between points i and j, which form the
+    // core set, widened to the cross product width
+    void
+    set_segment( std::size_t i, std::size_t j, double width)
+    {
+        core.clear();
+        core.push_back( i);
+        if ( j != i)
+            core.push_back( j);
+
+        Ellipse& e = current_ellipse;
+        e.empty = false;
+        e.degenerate = true;
+        e.x0 = point_x[ i]; e.y0 = point_y[ i];
+        e.x1 = point_x[ j]; e.y1 = point_y[ j];
+        e.cx = ( e.x0 + e.x1) / 2;
+        e.cy = ( e.y0 + e.y1) / 2;
+        e.width = width;
+    }
+
+    // the current ellipse scaled to pass through the farthest point
+    void
+    set_ellipse( double max_distance)
+    {
+        Ellipse& e = current_ellipse;
+        double f = 1 / ( max_distance * ( 1 + 1e-12));
+        e.empty = false;
+        e.degenerate = false;
+        e.cx = c_x;
+        e.cy = c_y;
+        e.m_a = s_a * f;
+        e.m_b = s_b * f;
+        e.m_c = s_c * f;
+    }
+
+    // the scatter matrix is singular: if every point is within rounding
+    // error of the line through core[ 0] and the point farthest from it,
+    // set the segment between the extreme points along that line.
+    // Otherwise add the point farthest off the line to the core set; if
+    // it is in there already, the points are too close to the line for
+    // the scatter matrix, and the segment is widened to contain them.
+    // True if the segment is set.
+    bool
+    collinear_core( )
+    {
+        std::size_t a = core[ 0], b = a, i;
+        double max_length = 0;
+        for ( i = 0; i < n_points; ++i) {
+            double length = std::fabs( point_x[ i] - point_x[ a])
+                          + std::fabs( point_y[ i] - point_y[ a]);
+            if ( length > max_length) {
+                max_length = length;
+                b = i;
+            }
+        }
+        double dx = point_x[ b] - point_x[ a], dy = point_y[ b] - point_y[ a];
+
+        std::size_t first = a, last = b, off = n_points;
+        double min_dot = 0, max_dot = dx * dx + dy * dy, max_cross = 0;
+        for ( i = 0; i < n_points; ++i) {
+            double ex = point_x[ i] - point_x[ a], ey = point_y[ i] - point_y[ a];
+            double cross = std::fabs( dx * ey - dy * ex), dot = dx * ex + dy * ey;
+            if ( cross > max_cross &&
+                 cross > 1e-12 * ( std::fabs( dx) + std::fabs( dy))
+                               * ( std::fabs( ex) + std::fabs( ey))) {
+                max_cross = cross;
+                off = i;
+            }
+            if ( dot < min_dot) { min_dot = dot; first = i; }
+            if ( dot > max_dot) { max_dot = dot; last = i; }
+        }
+        if ( off != n_points &&
+             std::find( core.begin(), core.end(), off) == core.end()) {
+            add_to_core( off);
+            return( false);
+        }
+
+        // the width with respect to the ends
+        dx = point_x[ last] - point_x[ first];
+        dy = point_y[ last] - point_y[ first];
+        double width = 0;
+        for ( i = 0; i < n_points; ++i)
+            width = (std::max)( width, std::fabs(
+                dx * ( point_y[ i] - point_y[ first])
+              - dy * ( point_x[ i] - point_x[ first])));
+        set_segment( first, last, width * ( 1 + 1e-12));
+        return( true);
+    }
+
+    void
+    compute( )
+    {
+        const double limit = 2 * ( 1 + eps) * ( 1 + eps);
+        const double core_limit = 2 * ( 1 + eps / 2) * ( 1 + eps / 2);
+        double max_distance = 0;
+        std::size_t i;
+
+        // Kumar-Yildirim initialization: extremes in x and perpendicular
+        // to the line through them
+        std::size_t i1 = extreme_point( 1, 0), i2 = extreme_point( -1, 0);
+        double dx = point_x[ i1] - point_x[ i2], dy = point_y[ i1] - point_y[ i2];
+        if ( dx == 0 && dy == 0) { dx = 1; dy = 0; }
+        add_to_core( i1);
+        add_to_core( i2);
+        add_to_core( extreme_point( -dy, dx));
+        add_to_core( extreme_point( dy, -dx));
+        std::fill( weight.begin(), weight.end(), 1.0 / core.size());
+
+        for ( ;;) {
+            if ( !optimize_core( core_limit)) {
+                // singular scatter matrix: start over with uniform
+                // weights, unless all points are on a line
+                if ( collinear_core())
+                    return;
+                weight.assign( core.size(), 1.0 / core.size());
+                continue;
+            }
+            ++n_scans;
+            i = farthest_point( max_distance);
+            // without convergence the farthest point may be in the core
+            // set already
+            if ( max_distance <= limit || !converged)
+                break;
+            add_to_core( i);
+        }
+        set_ellipse( max_distance);
+    }
+
+  public:
+    // Constructor
+    // -----------
+    // approximate ellipse of [ first, last) for the tolerance eps > 0; the
+    // range is traversed twice
+    template < class ForwardIterator >
+    Min_ellipse_2_khachiyan( ForwardIterator first,
+                             ForwardIterator last,
+                             double epsilon,
+                             const Traits& traits = Traits())
+        : tco( traits), eps( epsilon), n_points( 0),
+          c_x( 0), c_y( 0), s_a( 0), s_b( 0), s_c( 0),
+          n_scans( 0), n_iterations( 0), converged( true)
+    {
+        CGAL_optimisation_precondition( epsilon > 0);
+        load_points( first, last);
+        if ( n_points == 0)
+            return;
+        compute();
+
+        // fetch the core set points from the input, in input order
+        std::sort( core.begin(), core.end());
+        weight.clear();
+        support_points.reserve( core.size());
+        std::size_t index = 0, j = 0;
+        for ( ; first != last && j < core.size(); ++first, ++index)
+            if ( index == core[ j]) {
+                support_points.push_back( *first);
+                ++j;
+            }
+    }
+};
+
+} //namespace CGAL
+
+#endif // CGAL_MIN_ELLIPSE_2_KHACHIYAN_H
+
+// ===== EOF =================================================================
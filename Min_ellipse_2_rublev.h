@@ -3,14 +3,29 @@
 
 #include <CGAL/Optimisation/basic.h>
 #include <CGAL/Random.h>
-#include <list>
 #include <vector>
 #include <algorithm>
+#include <iterator>
 #include <iostream>
-#include <CGAL/ch_melkman.h>
 #include <CGAL/Polygon_2.h>
+#include <CGAL/ch_graham_andrew.h>
+#include <CGAL/ch_akl_toussaint.h>
+#include <cmath>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 
-CGAL_BEGIN_NAMESPACE
+#include "Min_ellipse_2_rublev_filter.h"
+
+// the statistics counters cost a few increments on the hot paths; define
+// CGAL_MIN_ELLIPSE_2_RUBLEV_NO_STATISTICS to compile them out
+#ifndef CGAL_MIN_ELLIPSE_2_RUBLEV_NO_STATISTICS
+#  define CGAL_MIN_ELLIPSE_2_RUBLEV_STATISTICS( statement) statement
+#else
+#  define CGAL_MIN_ELLIPSE_2_RUBLEV_STATISTICS( statement)
+#endif
+
+namespace CGAL {
 
 // Class declaration
 // =================
@@ -26,19 +41,240 @@ class Min_ellipse_2_rublev {
     typedef           Traits_                           Traits;
     typedef typename  Traits_::Point                    Point;
     typedef typename  Traits_::Ellipse                  Ellipse;
-    typedef typename  std::list<Point>::const_iterator  Point_iterator;
     typedef           const Point *                     Support_point_iterator;
+
+    // tag of the constructor which solves over the caller's points
+    struct View_tag { };
+
+    // random access iterator over the points of the solver, which are its
+    // own copy or, in view mode, the caller's points in the solver's order
+    class Point_iterator {
+      public:
+        typedef std::random_access_iterator_tag  iterator_category;
+        typedef Point                            value_type;
+        typedef std::ptrdiff_t                   difference_type;
+        typedef const Point*                     pointer;
+        typedef const Point&                     reference;
+
+        Point_iterator( ) : solver( 0), index( 0) { }
+        Point_iterator( const Min_ellipse_2_rublev<Traits_>* me, std::ptrdiff_t i)
+            : solver( me), index( i) { }
+
+        reference operator*( ) const { return( solver->point( index)); }
+        pointer operator->( ) const { return( &solver->point( index)); }
+        reference operator[]( difference_type n) const { return( solver->point( index + n)); }
+
+        Point_iterator& operator++( )    { ++index; return( *this); }
+        Point_iterator& operator--( )    { --index; return( *this); }
+        Point_iterator  operator++( int) { Point_iterator i( *this); ++index; return( i); }
+        Point_iterator  operator--( int) { Point_iterator i( *this); --index; return( i); }
+        Point_iterator& operator+=( difference_type n) { index += n; return( *this); }
+        Point_iterator& operator-=( difference_type n) { index -= n; return( *this); }
+        Point_iterator  operator+( difference_type n) const { return( Point_iterator( solver, index + n)); }
+        Point_iterator  operator-( difference_type n) const { return( Point_iterator( solver, index - n)); }
+        difference_type operator-( const Point_iterator& i) const { return( index - i.index); }
+        friend Point_iterator operator+( difference_type n, const Point_iterator& i) { return( i + n); }
+
+        bool operator==( const Point_iterator& i) const { return( index == i.index); }
+        bool operator!=( const Point_iterator& i) const { return( index != i.index); }
+        bool operator< ( const Point_iterator& i) const { return( index <  i.index); }
+        bool operator> ( const Point_iterator& i) const { return( index >  i.index); }
+        bool operator<=( const Point_iterator& i) const { return( index <= i.index); }
+        bool operator>=( const Point_iterator& i) const { return( index >= i.index); }
+
+      private:
+        const Min_ellipse_2_rublev<Traits_>* solver;
+        std::ptrdiff_t index;
+    };
+
+    // how the survivors of a pass are compacted in place: stable keeps
+    // the input order (and thus today's support sets), unstable moves the
+    // last survivor into every hole and touches less memory
+    enum Compaction { STABLE_COMPACTION, UNSTABLE_COMPACTION };
+
+    // how the sweeps without the convex hull heuristic react to points
+    // outside the ellipse: restart finishes the sweep and sweeps again if
+    // the ellipse changed, move-to-front does the same but moves every
+    // such point to the front of the point array (as in Welzl's
+    // algorithm), pivoting updates only with the most violating point of
+    // every sweep
+    enum Update_strategy { RESTART_UPDATES, MOVE_TO_FRONT_UPDATES,
+                           PIVOTING_UPDATES };
+
+    // solver options
+    //
+    // In parallel mode every pass classifies all points against the ellipse
+    // and the support hull at the start of the pass on n_threads threads
+    // (0: as many as OpenMP offers), then applies the violators in input
+    // order on one thread. The result does not depend on the number of
+    // threads. Parallel passes always use stable compaction.
+    //
+    // The update strategy applies to the sequential sweeps without the
+    // convex hull heuristic. With random_permutation set the points are
+    // shuffled (with random_seed) before the first sweep.
+    //
+    // In streaming mode (which implies the convex hull heuristic) points
+    // inside the convex hull of a support set are discarded for good: by
+    // insert() on arrival, and after every computation for all points the
+    // passes dropped. Only the remaining candidates are stored.
+    //
+    // With prefilter_directions set to K (3 to 16) the convex hull
+    // heuristic starts with an Akl-Toussaint prefilter: the points which
+    // are extreme in K equally spaced directions span a polygon, and the
+    // points certainly in its interior are dropped before the first pass.
+    // The extreme points are searched on n_threads threads in parallel
+    // mode. 0 disables the prefilter.
+    //
+    // With hull_first set the points are replaced by the vertices of their
+    // convex hull, which have the same ellipse, before anything else; in
+    // parallel mode the hulls of contiguous chunks are computed on
+    // n_threads threads and merged. The vertices are then shuffled as with
+    // random_permutation. As in streaming mode only the retained points
+    // are stored and number_of_pruned_points() counts the others.
+    //
+    // With divide_and_conquer set, the points are split into one
+    // contiguous chunk per thread (n_threads) and every chunk is solved on
+    // its own thread. The ellipse of the union of the chunks' support sets
+    // then seeds the passes over all points, which usually end after one
+    // verification pass. Small inputs are solved directly.
+    struct Options {
+        bool        use_convex_hull_heuristic;
+        Compaction  compaction;
+        bool        parallel;
+        int         n_threads;
+        bool        streaming;
+        Update_strategy update_strategy;
+        bool        random_permutation;
+        unsigned int random_seed;
+        int         prefilter_directions;
+        bool        hull_first;
+        bool        divide_and_conquer;
+
+        Options( )
+            : use_convex_hull_heuristic( true),
+              compaction( STABLE_COMPACTION),
+              parallel( false),
+              n_threads( 0),
+              streaming( false),
+              update_strategy( RESTART_UPDATES),
+              random_permutation( false),
+              random_seed( 0),
+              prefilter_directions( 0),
+              hull_first( false),
+              divide_and_conquer( false)
+        { }
+    };
+
+    // work done since construction or clear(), beyond number_of_passes()
+    // and number_of_updates(); all zero if the statistics are compiled out
+    struct Statistics {
+        // ellipse constructions by number of support points, including
+        // those found in the memo
+        std::size_t ellipse_constructions[ 6];
+        std::size_t memo_hits;
+        // most support points reached by the recursion of an update
+        int         max_support_depth;
+        // exact in-ellipse tests, i.e. filter failures and the tests of
+        // the recursion, and exact support hull tests
+        std::size_t exact_ellipse_tests;
+        std::size_t exact_hull_tests;
+        // points dropped because they are inside the support hull
+        std::size_t hull_rejections;
+
+        Statistics( )
+            : memo_hits( 0), max_support_depth( 0), exact_ellipse_tests( 0),
+              exact_hull_tests( 0), hull_rejections( 0)
+        {
+            for ( int i = 0; i < 6; ++i)
+                ellipse_constructions[ i] = 0;
+        }
+    };
     
   private:
     // private data members
     Traits       tco;                           // traits class object
-    std::list<Point>  points;                   // doubly linked list of points
+    Ellipse      current_ellipse;               // current ellipse
+    std::vector<Point>  points;                 // contiguous array of points
     int          n_support_points;              // number of support points
-    Point*       support_points;                // array of support points
+    Point        support_points[ 5];            // array of support points
 	
-	bool use_convex_hull_heuristic;
+	Options options;
 	int n_convex_hull_points;
-	Point* convex_hull;    
+	Point convex_hull[ 5];    
+
+	// indices and double coordinates of the points which survived the
+	// previous pass; compacted in place by every pass of
+	// me_with_convex_hull_heuristic()
+	std::vector< std::size_t> survivors;
+	std::vector< double> survivor_x, survivor_y;
+
+	// double approximations of points[ 0, n_loaded_points) and the
+	// floating-point filter for the current ellipse
+	std::vector< double> point_x, point_y;
+	std::size_t n_loaded_points;
+	std::size_t n_pruned_points;                // discarded in streaming mode
+	std::size_t n_passes;                       // sweeps over the points
+	std::size_t n_updates;                      // calls of update_ellipse()
+	mutable Statistics stats;                   // counted by const tests too
+	typedef Min_ellipse_2_rublev_filter< Traits_ > Filter;
+	Filter filter;
+	Min_ellipse_2_rublev_hull_filter< Traits_ > hull_filter;
+
+	// exact in-ellipse test of the 4 and 5 point ellipses, prepared with
+	// the filter and valid as long as the support set
+	Min_ellipse_2_rublev_predicate< Traits_ > predicate;
+
+	// Akl-Toussaint prefilter: the extreme points, their convex hull and
+	// its filter, and the number of points examined and dropped since
+	// construction or clear()
+	std::vector< Point> extremes, extremes_hull;
+	Min_ellipse_2_rublev_hull_filter< Traits_ > extremes_filter;
+	std::size_t n_prefilter_input;
+	std::size_t n_prefiltered_points;
+
+	// hull first mode: hulls of the chunks and their merged hull, which
+	// becomes the point set
+	std::vector< std::vector< Point> > chunk_hulls;
+	std::vector< Point> hull_points;
+
+	// warm start: the hints of the next computation
+	std::vector< Point> hint_points;
+
+	// view mode: point i is view_points[ view_order[ i]] instead of
+	// points[ i]; view_order is created by the first permutation and
+	// empty as long as the order is the caller's
+	const Point* view_points;
+	std::size_t  n_view_points;
+	std::vector< std::size_t> view_order;
+
+	// per chunk results of a parallel pass: number of kept survivors and
+	// indices of the points which were not certainly inside the ellipse
+	std::vector< std::size_t> chunk_kept;
+	std::vector< std::vector< std::size_t> > chunk_candidates;
+
+	// points are classified by the filter in blocks of this size
+	enum { block_size = 256 };
+
+	// indices into points of the support points, and the support set
+	// before the current update
+	std::size_t support_ids[ 5];
+	Point old_support[ 5];
+	std::size_t old_ids[ 5];
+
+	// support count as a type, selects the ellipse construction
+	template < int N > struct Support_count { };
+
+	// ellipses through 3 to 5 support points, keyed by the sorted indices
+	// of the points; direct mapped
+	struct Memo_entry {
+		int n;
+		std::size_t ids[ 5];
+		Ellipse ellipse;
+
+		Memo_entry( ) : n( -1) { }
+	};
+	enum { memo_size = 64 };
+	std::vector< Memo_entry> memo;
 
     // copying and assignment not allowed!
     Min_ellipse_2_rublev( const Min_ellipse_2_rublev<Traits_>&);
@@ -57,9 +293,58 @@ class Min_ellipse_2_rublev {
     int
     number_of_points( ) const
     {
-        return( points.size());
+        return( point_count());
     }
     
+    // number of points discarded in streaming or hull first mode;
+    // number_of_points() counts the retained ones
+    inline
+    std::size_t
+    number_of_pruned_points( ) const
+    {
+        return( n_pruned_points);
+    }
+
+    // number of sweeps over the points and of ellipse updates since
+    // construction or clear()
+    inline
+    std::size_t
+    number_of_passes( ) const
+    {
+        return( n_passes);
+    }
+
+    inline
+    std::size_t
+    number_of_updates( ) const
+    {
+        return( n_updates);
+    }
+
+    // number of points the Akl-Toussaint prefilter dropped, and their
+    // share of the points it examined, since construction or clear()
+    inline
+    std::size_t
+    number_of_prefiltered_points( ) const
+    {
+        return( n_prefiltered_points);
+    }
+
+    inline
+    double
+    prefilter_reduction_ratio( ) const
+    {
+        return( n_prefilter_input == 0 ? 0.0
+                : double( n_prefiltered_points) / double( n_prefilter_input));
+    }
+
+    inline
+    const Statistics&
+    statistics( ) const
+    {
+        return( stats);
+    }
+
     inline
     int
     number_of_support_points( ) const
@@ -82,19 +367,37 @@ class Min_ellipse_2_rublev {
         return( number_of_support_points() <  3);
     }
 
+    // does the solver refer to the caller's points instead of a copy?
+    inline
+    bool
+    is_view( ) const
+    {
+        return( view_points != 0);
+    }
+
     // access to points and support points
     inline
     Point_iterator
     points_begin( ) const
     {
-        return( points.begin());
+        return( Point_iterator( this, 0));
     }
     
     inline
     Point_iterator
     points_end( ) const
     {
-        return( points.end());
+        return( Point_iterator( this, std::ptrdiff_t( point_count())));
+    }
+
+    // random access for points
+    inline
+    const Point&
+    point( std::size_t i) const
+    {
+        if ( view_points == 0)
+            return( points[ i]);
+        return( view_points[ view_order.empty() ? i : view_order[ i]]);
     }
     
     inline
@@ -120,12 +423,24 @@ class Min_ellipse_2_rublev {
                                         (i <  number_of_support_points()));
         return( support_points[ i]);
     }
+
+    // position of support point i in [points_begin(), points_end()); this
+    // is its input position unless the points were permuted (random
+    // permutation, move-to-front) or pruned (streaming)
+    inline
+    std::size_t
+    support_point_index( int i) const
+    {
+        CGAL_optimisation_precondition( (i >= 0) &&
+                                        (i <  number_of_support_points()));
+        return( support_ids[ i]);
+    }
     // ellipse
     inline
     const Ellipse&
     ellipse( ) const
     {
-        return( tco.ellipse);
+        return( current_ellipse);
     }
     
     // in-ellipse test predicates
@@ -133,199 +448,1169 @@ class Min_ellipse_2_rublev {
     CGAL::Bounded_side
     bounded_side( const Point& p) const
     {
-        return( tco.ellipse.bounded_side( p));
+        switch ( filtered_side( p)) {
+          case  1: return( CGAL::ON_UNBOUNDED_SIDE);
+          case -1: return( CGAL::ON_BOUNDED_SIDE);
+          default: return( exact_bounded_side( p));
+        }
     }
     
     inline
     bool
     has_on_bounded_side( const Point& p) const
     {
-        return( tco.ellipse.has_on_bounded_side( p));
+        int side = filtered_side( p);
+        if ( side != 0) return( side < 0);
+        return( exact_bounded_side( p) == CGAL::ON_BOUNDED_SIDE);
     }
     
     inline
     bool
     has_on_boundary( const Point& p) const
     {
-        return( tco.ellipse.has_on_boundary( p));
+        if ( filtered_side( p) != 0) return( false);
+        return( exact_bounded_side( p) == CGAL::ON_BOUNDARY);
     }
     
     inline
     bool
     has_on_unbounded_side( const Point& p) const
     {
-        return( tco.ellipse.has_on_unbounded_side( p));
+        int side = filtered_side( p);
+        if ( side != 0) return( side > 0);
+        return( exact_bounded_side( p) == CGAL::ON_UNBOUNDED_SIDE);
     }
 
   private:
     // Private member functions
     // ------------------------
-	inline
-	void update_ellipse_old( Point add )
-	{
-		  int i;
-		  Min_ellipse_2< Traits_ > algo( add);
-		  algo.insert( support_points + 0, support_points + n_support_points);
-		  n_support_points = algo.number_of_support_points();
-		  for (i = 0; i < n_support_points; ++i)
-			  support_points[i] = algo.support_point(i);
-		  tco = algo.traits();
-	} 
+	inline std::size_t
+		point_count ( ) const
+	{
+		return ( view_points == 0 ? points.size() : n_view_points);
+	}
+
+	// make the order of a view explicit before it is permuted
+	inline void
+		make_view_order ( )
+	{
+		if ( view_points == 0 || !view_order.empty())
+			return;
+		view_order.resize( n_view_points);
+		for ( std::size_t i = 0; i < n_view_points; ++i)
+			view_order[ i] = i;
+	}
+
+	// exchange points i and j
+	inline void
+		swap_points ( std::size_t i, std::size_t j)
+	{
+		if ( view_points == 0)
+			std::swap( points[ i], points[ j]);
+		else
+			std::swap( view_order[ i], view_order[ j]);
+	}
+
+	// copy the viewed points in their current order and leave view mode
+	inline void
+		copy_view ( )
+	{
+		if ( view_points == 0)
+			return;
+		points.clear();
+		points.reserve( n_view_points);
+		for ( std::size_t i = 0; i < n_view_points; ++i)
+			points.push_back( point( i));
+		view_points = 0;
+		n_view_points = 0;
+		view_order.clear();
+	}
+
+	inline int
+		filtered_side ( const Point& p) const
+	{
+		return ( filter.side( CGAL::to_double( p.x()), CGAL::to_double( p.y())));
+	}
+
+	// exact in-ellipse test of the current ellipse; the 4 and 5 point
+	// ellipses go through the cached predicate instead of the pencil
+	inline CGAL::Bounded_side
+		exact_bounded_side ( const Point& p) const
+	{
+		if ( predicate.is_set())
+			return ( predicate.bounded_side( p));
+		return ( current_ellipse.bounded_side( p));
+	}
+
+	// in-ellipse test for points[ i] whose filtered side is already known;
+	// exact only if the filter failed
+	inline bool
+		is_outlier ( std::size_t i, int side) const
+	{
+		if ( side != 0)
+			return ( side > 0);
+		CGAL_MIN_ELLIPSE_2_RUBLEV_STATISTICS( ++stats.exact_ellipse_tests);
+		return ( exact_bounded_side( point( i)) == CGAL::ON_UNBOUNDED_SIDE);
+	}
+
+	// extend the double approximations to all points and widen the range
+	// of the filter accordingly
+	inline void
+		load_coordinates ( )
+	{
+		double max_x = filter.range_x(), max_y = filter.range_y();
+
+		const std::size_t n = point_count();
+		point_x.resize( n);
+		point_y.resize( n);
+		for ( ; n_loaded_points < n; ++n_loaded_points)
+		{
+			const Point& p = point( n_loaded_points);
+			double x = CGAL::to_double( p.x());
+			double y = CGAL::to_double( p.y());
+			point_x[ n_loaded_points] = x;
+			point_y[ n_loaded_points] = y;
+			max_x = (std::max)( max_x, std::fabs( x));
+			max_y = (std::max)( max_y, std::fabs( y));
+		}
+		filter.set_range( max_x, max_y);
+		hull_filter.set_range( max_x, max_y);
+	}
+
+	inline void
+		update_filter ( )
+	{
+		filter.set( support_points, n_support_points);
+		predicate.set( support_points, n_support_points);
+	}
+
+	// ellipse through support_points[ 0, N) for a support count known at
+	// compile time
+	inline void set_ellipse( Support_count< 0>)
+	{
+		current_ellipse.set( );
+	}
+
+	inline void set_ellipse( Support_count< 1>)
+	{
+		current_ellipse.set( support_points[ 0]);
+	}
+
+	inline void set_ellipse( Support_count< 2>)
+	{
+		current_ellipse.set( support_points[ 0], support_points[ 1]);
+	}
+
+	inline void set_ellipse( Support_count< 3>)
+	{
+		current_ellipse.set( support_points[ 0],
+		                 support_points[ 1],
+		                 support_points[ 2]);
+	}
+
+	inline void set_ellipse( Support_count< 4>)
+	{
+		current_ellipse.set( support_points[ 0],
+		                 support_points[ 1],
+		                 support_points[ 2],
+		                 support_points[ 3]);
+	}
+
+	inline void set_ellipse( Support_count< 5>)
+	{
+		current_ellipse.set( support_points[ 0],
+		                 support_points[ 1],
+		                 support_points[ 2],
+		                 support_points[ 3],
+		                 support_points[ 4]);
+	}
+
+	// memo slot of the support set support_ids[ 0, n); the ids are sorted
+	// into key first
+	inline std::size_t
+		memo_slot ( int n, std::size_t* key) const
+	{
+		std::size_t h = n, t;
+		int i, j;
+		for ( i = 0; i < n; ++i)
+			key[ i] = support_ids[ i];
+		for ( i = 1; i < n; ++i)
+			for ( j = i; j > 0 && key[ j-1] > key[ j]; --j)
+			{
+				t = key[ j]; key[ j] = key[ j-1]; key[ j-1] = t;
+			}
+		for ( i = 0; i < n; ++i)
+			h = h * 1000003u ^ key[ i];
+		return ( h % memo_size);
+	}
+
+	// set the ellipse through the N support points; ellipses through three
+	// or more points are exact constructions and are looked up in the memo
+	// first
+	template < int N >
+	inline void
+		compute_ellipse ( Support_count< N> count)
+	{
+		n_support_points = N;
+		CGAL_MIN_ELLIPSE_2_RUBLEV_STATISTICS( ++stats.ellipse_constructions[ N]);
+		if ( N < 3)
+		{
+			set_ellipse( count);
+			return;
+		}
+
+		std::size_t key[ 5];
+		if ( memo.empty())
+			memo.resize( memo_size);
+		Memo_entry& entry = memo[ memo_slot( N, key)];
+		if ( entry.n == N && std::equal( key, key + N, entry.ids))
+		{
+			CGAL_MIN_ELLIPSE_2_RUBLEV_STATISTICS( ++stats.memo_hits);
+			current_ellipse = entry.ellipse;
+			return;
+		}
+		set_ellipse( count);
+		entry.n = N;
+		std::copy( key, key + N, entry.ids);
+		entry.ellipse = current_ellipse;
+	}
 
 	inline void
 		compute_ellipse( )
-    {
-        switch ( n_support_points) {
-          case 5:
-            tco.ellipse.set( support_points[ 0],
-                             support_points[ 1],
-                             support_points[ 2],
-                             support_points[ 3],
-                             support_points[ 4]);
-            break;
-          case 4:
-            tco.ellipse.set( support_points[ 0],
-                             support_points[ 1],
-                             support_points[ 2],
-                             support_points[ 3]);
-            break;
-          case 3:
-            tco.ellipse.set( support_points[ 0],
-                             support_points[ 1],
-                             support_points[ 2]);
-            break;
-          case 2:
-            tco.ellipse.set( support_points[ 0], support_points[ 1]);
-            break;
-          case 1:
-            tco.ellipse.set( support_points[ 0]);
-            break;
-          case 0:
-            tco.ellipse.set( );
-            break;
-          default:
-            CGAL_optimisation_assertion( ( n_support_points >= 0) &&
-                                         ( n_support_points <= 5) ); }
-    }
-
-	inline void 
-		me_recursive_support ( Point* first, const Point* last, int n_sp)
-    {
-        // compute ellipse through support points
-        n_support_points = n_sp;
-        compute_ellipse();
-        if ( n_sp == 5) return;
-    
-        // test first n points
-		Point* point_iter;
-        for ( 
-			point_iter = first; 
-			last != point_iter; )
-		{
-            const Point& p = *point_iter;
-    
-            // p not in current ellipse?
-            if ( has_on_unbounded_side( p))
+	{
+		switch ( n_support_points) {
+		  case 5: compute_ellipse( Support_count< 5>()); break;
+		  case 4: compute_ellipse( Support_count< 4>()); break;
+		  case 3: compute_ellipse( Support_count< 3>()); break;
+		  case 2: compute_ellipse( Support_count< 2>()); break;
+		  case 1: compute_ellipse( Support_count< 1>()); break;
+		  case 0: compute_ellipse( Support_count< 0>()); break;
+		  default:
+			CGAL_optimisation_assertion( ( n_support_points >= 0) &&
+			                             ( n_support_points <= 5) ); }
+	}
+
+	// smallest ellipse of old_support[ 0, last) with support_points[ 0, N)
+	// on the boundary. The recursion depth is bounded by the support count,
+	// which is a template argument, so every level is a separate function
+	// and the ellipse constructor is chosen at compile time.
+	template < int N >
+	inline void
+		me_support ( std::size_t last, Support_count< N>)
+	{
+		compute_ellipse( Support_count< N>());
+		CGAL_MIN_ELLIPSE_2_RUBLEV_STATISTICS(
+			stats.max_support_depth = (std::max)( stats.max_support_depth, N));
+
+		for ( std::size_t j = 0; j < last; ++j)
+		{
+			// old_support[ j] not in current ellipse?
+			CGAL_MIN_ELLIPSE_2_RUBLEV_STATISTICS( ++stats.exact_ellipse_tests);
+			if ( current_ellipse.has_on_unbounded_side( old_support[ j]))
 			{
-				// recursive call with p as additional support point
-                support_points[ n_sp] = p;
-                me_recursive_support( first, point_iter, n_sp+1);
+				// continue with old_support[ j] as additional support
+				// point; it is on the boundary of the result
+				support_points[ N] = old_support[ j];
+				support_ids[ N] = old_ids[ j];
+				me_support( j, Support_count< N+1>());
 			}
-            else
-                ++point_iter;
 		}
-    }
+	}
 
 	inline void
-		update_ellipse( Point add )
+		me_support ( std::size_t, Support_count< 5>)
 	{
-		Point points[5];
-		int n_sp = n_support_points;
-		for (int i = 0; i < n_support_points; ++i)
-			points[ i] = support_points[ i];
-		
-		support_points[ 0] = add;
+		compute_ellipse( Support_count< 5>());
+		CGAL_MIN_ELLIPSE_2_RUBLEV_STATISTICS( stats.max_support_depth = 5);
+	}
+
+	// recompute the ellipse after points[ add] turned out to be outside
+	inline void
+		update_ellipse( std::size_t add )
+	{
+		std::size_t n_sp = n_support_points;
+		for ( std::size_t i = 0; i < n_sp; ++i)
+		{
+			old_support[ i] = support_points[ i];
+			old_ids[ i] = support_ids[ i];
+		}
 
-		me_recursive_support( points + 0, points + n_sp, 1);
+		support_points[ 0] = point( add);
+		support_ids[ 0] = add;
+		++n_updates;
+
+		me_support( n_sp, Support_count< 1>());
+		update_filter();
 	} 
 
+	// The support points lie on the boundary of the ellipse and are thus in
+	// convex position: their hull is the support set in counterclockwise
+	// order around support_points[ 0], computed in place.
 	inline void
 		compute_convex_hull ()
 	{
-		std::vector< Point > basis;
-		ch_melkman ( suppo	rt_points + 0, support_points + n_support_points , std::back_inserter( basis), Point::R ());
+		typename Point::R::Orientation_2 orientation =
+			typename Point::R().orientation_2_object();
+		int i, j;
+
+		n_convex_hull_points = n_support_points;
+		for ( i = 0; i < n_support_points; ++i)
+			convex_hull[ i] = support_points[ i];
+		for ( i = 2; i < n_convex_hull_points; ++i)
+			for ( j = i; j > 1 && orientation( convex_hull[ 0], convex_hull[ j],
+			                                   convex_hull[ j-1]) == COUNTERCLOCKWISE; --j)
+				std::swap( convex_hull[ j], convex_hull[ j-1]);
+		hull_filter.set( convex_hull, n_convex_hull_points);
+	}
+
+	inline bool
+		is_dominated ( const Point& p) const
+	{
+		CGAL_MIN_ELLIPSE_2_RUBLEV_STATISTICS( ++stats.exact_hull_tests);
+		return ( bounded_side_2( convex_hull + 0, convex_hull + n_convex_hull_points, p, typename Point::R()) == ON_BOUNDED_SIDE);
+	}
+
+	inline void
+		keep_survivor ( std::size_t to, std::size_t from)
+	{
+		survivors[ to] = survivors[ from];
+		survivor_x[ to] = survivor_x[ from];
+		survivor_y[ to] = survivor_y[ from];
+	}
+
+	// one pass over survivors[ 0, n_alive); returns the number of points
+	// kept for the next pass, in their original order. The hull and ellipse
+	// sides of a block are classified at once and reclassified after every
+	// update. Points which are inside the hull but too close to its
+	// boundary for the filter are kept; they are inside the ellipse anyway.
+	inline std::size_t
+		stable_pass ( std::size_t n_alive, bool& outlier)
+	{
+		signed char sides[ block_size];
+		std::size_t base, m, k, i, n_kept = 0;
+
+		for ( base = 0; base < n_alive; base += m)
+		{
+			m = (std::min)( std::size_t( block_size), n_alive - base);
+			filter.side( &survivor_x[ base], &survivor_y[ base], m, hull_filter, sides);
+
+			for ( k = 0; k < m; ++k)
+			{
+				i = base + k;
+				if ( sides[ k] != Filter::dominated)
+				{
+					keep_survivor( n_kept++, i);
+
+					if ( is_outlier( survivors[ i], sides[ k]))
+					{
+						update_ellipse( survivors[ i]);
+						outlier = true;
+						compute_convex_hull();
+						filter.side( &survivor_x[ 0] + i+1, &survivor_y[ 0] + i+1,
+						             m-k-1, hull_filter, sides+k+1);
+					}
+				}
+			}
+		}
+		CGAL_MIN_ELLIPSE_2_RUBLEV_STATISTICS( stats.hull_rejections += n_alive - n_kept);
+		return n_kept;
+	}
+
+	// same as stable_pass(), but every dominated point is replaced by the
+	// last survivor instead of shifting the tail; the moved point has not
+	// been classified with its new block and is tested on its own
+	inline std::size_t
+		unstable_pass ( std::size_t n_alive, bool& outlier)
+	{
+		signed char sides[ block_size];
+		std::size_t base, m, k, i;
+
+		for ( base = 0; base < n_alive; base += m)
+		{
+			m = (std::min)( std::size_t( block_size), n_alive - base);
+			filter.side( &survivor_x[ base], &survivor_y[ base], m, hull_filter, sides);
+
+			for ( k = 0; k < m; )
+			{
+				i = base + k;
+				if ( sides[ k] == Filter::dominated)
+				{
+					CGAL_MIN_ELLIPSE_2_RUBLEV_STATISTICS( ++stats.hull_rejections);
+					keep_survivor( i, --n_alive);
+					if ( n_alive < base + m)
+						m = n_alive - base;
+					if ( k < m)
+						sides[ k] = static_cast<signed char>(
+							filter.side( survivor_x[ i], survivor_y[ i], hull_filter));
+					continue;
+				}
+
+				if ( is_outlier( survivors[ i], sides[ k]))
+				{
+					update_ellipse( survivors[ i]);
+					outlier = true;
+					compute_convex_hull();
+					filter.side( &survivor_x[ 0] + i+1, &survivor_y[ 0] + i+1,
+					             m-k-1, hull_filter, sides+k+1);
+				}
+				++k;
+			}
+		}
+		return n_alive;
+	}
+
+	inline int
+		number_of_threads ( ) const
+	{
+#ifdef _OPENMP
+		return ( options.n_threads > 0 ? options.n_threads : omp_get_max_threads());
+#else
+		return ( 1);
+#endif
+	}
+
+	// split [ 0, n) into contiguous chunks, a few per thread
+	inline std::size_t
+		prepare_chunks ( std::size_t n)
+	{
+		std::size_t n_chunks = (std::min)( std::size_t( 4 * number_of_threads()),
+		                                   ( n + block_size - 1) / block_size);
+		if ( n_chunks == 0)
+			n_chunks = 1;
+
+		chunk_kept.assign( n_chunks, 0);
+		chunk_candidates.resize( n_chunks);
+		for ( std::size_t c = 0; c < n_chunks; ++c)
+			chunk_candidates[ c].clear();
+		return n_chunks;
+	}
+
+	// test the candidates collected by a parallel pass in input order
+	// against the current ellipse; only this part changes the ellipse
+	inline void
+		apply_candidates ( bool& outlier, bool with_hull)
+	{
+		for ( std::size_t c = 0; c < chunk_candidates.size(); ++c)
+		{
+			const std::vector< std::size_t>& candidates = chunk_candidates[ c];
+			for ( std::size_t j = 0; j < candidates.size(); ++j)
+			{
+				std::size_t idx = candidates[ j];
+				if ( is_outlier( idx, filter.side( point_x[ idx], point_y[ idx])))
+				{
+					update_ellipse( idx);
+					outlier = true;
+					if ( with_hull)
+						compute_convex_hull();
+				}
+			}
+		}
+	}
+
+	// parallel counterpart of stable_pass(): the chunks classify their
+	// survivors against the ellipse and hull of the start of the pass and
+	// compact them in place, then the kept ranges are joined and the
+	// candidates applied
+	inline std::size_t
+		parallel_pass ( std::size_t n_alive, bool& outlier)
+	{
+		std::size_t n_chunks = prepare_chunks( n_alive);
+		std::size_t chunk = ( n_alive + n_chunks - 1) / n_chunks;
+		std::size_t c, n_kept;
+		long chunk_index;
+
+#ifdef _OPENMP
+#pragma omp parallel for schedule( static) num_threads( number_of_threads())
+#endif
+		for ( chunk_index = 0; chunk_index < long( n_chunks); ++chunk_index)
+		{
+			signed char sides[ block_size];
+			std::size_t first = chunk_index * chunk;
+			std::size_t last = (std::min)( first + chunk, n_alive);
+			std::size_t base, m, k, i, kept = first;
+			std::vector< std::size_t>& candidates = chunk_candidates[ chunk_index];
+
+			for ( base = first; base < last; base += m)
+			{
+				m = (std::min)( std::size_t( block_size), last - base);
+				filter.side( &survivor_x[ base], &survivor_y[ base], m, hull_filter, sides);
+
+				for ( k = 0; k < m; ++k)
+				{
+					i = base + k;
+					if ( sides[ k] == Filter::dominated)
+						continue;
+
+					if ( sides[ k] >= 0)
+						candidates.push_back( survivors[ i]);
+					keep_survivor( kept++, i);
+				}
+			}
+			chunk_kept[ chunk_index] = kept - first;
+		}
+
+		// join the kept ranges; they only move towards the front
+		for ( c = 0, n_kept = 0; c < n_chunks; ++c)
+		{
+			std::size_t first = c * chunk;
+			if ( n_kept != first)
+				for ( std::size_t j = 0; j < chunk_kept[ c]; ++j)
+					keep_survivor( n_kept + j, first + j);
+			n_kept += chunk_kept[ c];
+		}
+		CGAL_MIN_ELLIPSE_2_RUBLEV_STATISTICS( stats.hull_rejections += n_alive - n_kept);
+
+		apply_candidates( outlier, true);
+		return n_kept;
+	}
+
+	// parallel counterpart of a pass of me()
+	inline void
+		parallel_plain_pass ( bool& outlier)
+	{
+		std::size_t n = point_count();
+		std::size_t n_chunks = prepare_chunks( n);
+		std::size_t chunk = ( n + n_chunks - 1) / n_chunks;
+		long chunk_index;
+
+#ifdef _OPENMP
+#pragma omp parallel for schedule( static) num_threads( number_of_threads())
+#endif
+		for ( chunk_index = 0; chunk_index < long( n_chunks); ++chunk_index)
+		{
+			signed char sides[ block_size];
+			std::size_t first = chunk_index * chunk;
+			std::size_t last = (std::min)( first + chunk, n);
+			std::size_t base, m, k;
+			std::vector< std::size_t>& candidates = chunk_candidates[ chunk_index];
+
+			for ( base = first; base < last; base += m)
+			{
+				m = (std::min)( std::size_t( block_size), last - base);
+				filter.side( &point_x[ base], &point_y[ base], m, sides);
+				for ( k = 0; k < m; ++k)
+					if ( sides[ k] >= 0)
+						candidates.push_back( base + k);
+			}
+		}
+
+		apply_candidates( outlier, false);
+	}
+
+	// streaming mode: keep only survivors[ 0, n_alive) of the last pass, in
+	// input order. All other points are inside the convex hull of some
+	// support set and can never become support points again.
+	inline void
+		discard_pruned_points ( std::size_t n_alive)
+	{
+		std::size_t i, j;
+		int k;
+
+		const std::size_t n = point_count();
+		if ( n_alive == n)
+			return;
+		make_view_order();
+		if ( options.compaction == UNSTABLE_COMPACTION && !options.parallel)
+			std::sort( survivors.begin(), survivors.begin() + n_alive);
+
+		for ( j = 0; j < n_alive; ++j)
+		{
+			i = survivors[ j];
+			for ( k = 0; k < n_support_points; ++k)
+				if ( support_ids[ k] == i)
+					support_ids[ k] = j;
+			if ( i != j)
+			{
+				if ( view_points == 0)
+					points[ j] = points[ i];
+				else
+					view_order[ j] = view_order[ i];
+				point_x[ j] = point_x[ i];
+				point_y[ j] = point_y[ i];
+			}
+		}
+
+		n_pruned_points += n - n_alive;
+		if ( view_points == 0)
+			points.erase( points.begin() + n_alive, points.end());
+		else
+		{
+			view_order.resize( n_alive);
+			n_view_points = n_alive;
+		}
+		point_x.resize( n_alive);
+		point_y.resize( n_alive);
+		n_loaded_points = n_alive;
+
+		// the memo is keyed by indices, which have changed
+		for ( i = 0; i < memo.size(); ++i)
+			memo[ i].n = -1;
+	}
+
+	// Akl-Toussaint prefilter: store the points which are not certainly
+	// inside the convex hull of the extreme points as the survivors and
+	// return their number. The dropped points are inside the hull of input
+	// points, hence inside the ellipse.
+	inline std::size_t
+		prefilter_survivors ( )
+	{
+		enum { max_directions = Min_ellipse_2_rublev_hull_filter< Traits_ >::max_edges };
+		const int n_directions = (std::min)( options.prefilter_directions, int( max_directions));
+		const std::size_t n = point_count();
+		double dx[ max_directions], dy[ max_directions], best_value[ max_directions];
+		std::size_t best[ max_directions], n_alive, i;
+		int k;
+
+		for ( k = 0; k < n_directions; ++k)
+		{
+			double angle = 6.283185307179586 * k / n_directions;
+			dx[ k] = std::cos( angle);
+			dy[ k] = std::sin( angle);
+			best_value[ k] = -HUGE_VAL;
+			best[ k] = n;
+		}
+
+		// extreme point in every direction, the first one on ties
+#ifdef _OPENMP
+#pragma omp parallel num_threads( number_of_threads()) if ( options.parallel)
+#endif
+		{
+			double value[ max_directions];
+			std::size_t index[ max_directions];
+			long j;
+			int d;
+
+			for ( d = 0; d < n_directions; ++d)
+			{
+				value[ d] = -HUGE_VAL;
+				index[ d] = n;
+			}
+#ifdef _OPENMP
+#pragma omp for schedule( static) nowait
+#endif
+			for ( j = 0; j < long( n); ++j)
+				for ( d = 0; d < n_directions; ++d)
+				{
+					double v = dx[ d] * point_x[ j] + dy[ d] * point_y[ j];
+					if ( v > value[ d])
+					{
+						value[ d] = v;
+						index[ d] = j;
+					}
+				}
+#ifdef _OPENMP
+#pragma omp critical
+#endif
+			for ( d = 0; d < n_directions; ++d)
+				if ( value[ d] > best_value[ d] ||
+				     ( value[ d] == best_value[ d] && index[ d] < best[ d]))
+				{
+					best_value[ d] = value[ d];
+					best[ d] = index[ d];
+				}
+		}
+
+		std::sort( best, best + n_directions);
+		extremes.clear();
+		extremes_hull.clear();
+		for ( k = 0; k < n_directions; ++k)
+			if ( best[ k] < n && ( k == 0 || best[ k] != best[ k-1]))
+				extremes.push_back( point( best[ k]));
+		CGAL::ch_graham_andrew( extremes.begin(), extremes.end(),
+		                        std::back_inserter( extremes_hull));
+
+		extremes_filter.set_range( filter.range_x(), filter.range_y());
+		if ( extremes_hull.size() >= 3)
+			extremes_filter.set( &extremes_hull[ 0], int( extremes_hull.size()));
+		else
+			extremes_filter.set( 0, 0);
+
+		// keep the other points, compacted per chunk, then join the chunks
+		std::size_t n_chunks = 1, chunk, c;
+		long chunk_index;
+		if ( options.parallel)
+			n_chunks = prepare_chunks( n);
+		else
+			chunk_kept.assign( 1, 0);
+		chunk = ( n + n_chunks - 1) / n_chunks;
 
-		n_convex_hull_points = basis.size();
-		for (int i = 0; i < basis.size(); ++i)
-			convex_hull[ i] = basis[ i];
+#ifdef _OPENMP
+#pragma omp parallel for schedule( static) num_threads( number_of_threads()) if ( options.parallel)
+#endif
+		for ( chunk_index = 0; chunk_index < long( n_chunks); ++chunk_index)
+		{
+			std::size_t first = chunk_index * chunk;
+			std::size_t last = (std::min)( first + chunk, n);
+			std::size_t j, kept = first;
+
+			for ( j = first; j < last; ++j)
+				if ( !extremes_filter.has_on_bounded_side( point_x[ j], point_y[ j]))
+				{
+					survivors[ kept] = j;
+					survivor_x[ kept] = point_x[ j];
+					survivor_y[ kept] = point_y[ j];
+					++kept;
+				}
+			chunk_kept[ chunk_index] = kept - first;
+		}
+
+		for ( c = 0, n_alive = 0; c < n_chunks; ++c)
+		{
+			std::size_t first = c * chunk;
+			if ( n_alive != first)
+				for ( i = 0; i < chunk_kept[ c]; ++i)
+					keep_survivor( n_alive + i, first + i);
+			n_alive += chunk_kept[ c];
+		}
+
+		n_prefilter_input += n;
+		n_prefiltered_points += n - n_alive;
+		return n_alive;
 	}
 
 	inline void
     me_with_convex_hull_heuristic( )
     {
-		std::list< Point > 
-			iter_points[ 2];
-		typename std::list< Point >::iterator last, point_iter;
-		int cur_iter = 0;
+		std::size_t n_alive = point_count(), i;
 		bool outlier = true;
 
+		load_coordinates();
 		compute_ellipse();
-		std::copy( points.begin(), points.end(), std::back_inserter( iter_points[ cur_iter]));
+		update_filter();
+
+		survivors.resize( n_alive);
+		survivor_x.resize( n_alive);
+		survivor_y.resize( n_alive);
+		if ( options.prefilter_directions >= 3)
+			n_alive = prefilter_survivors();
+		else
+			for ( i = 0; i < n_alive; ++i)
+			{
+				survivors[ i] = i;
+				survivor_x[ i] = point_x[ i];
+				survivor_y[ i] = point_y[ i];
+			}
 
 		compute_convex_hull();
 
 		while ( outlier)
 		{
 			outlier = false;
-			last = iter_points[ cur_iter].end();
+			++n_passes;
 
-			for ( point_iter = iter_points[ cur_iter].begin(); point_iter != last; point_iter++)
-			{
-				const Point& p = *point_iter;
+			if ( options.parallel)
+				n_alive = parallel_pass( n_alive, outlier);
+			else if ( options.compaction == STABLE_COMPACTION)
+				n_alive = stable_pass( n_alive, outlier);
+			else
+				n_alive = unstable_pass( n_alive, outlier);
+		}
 
-				if ( bounded_side_2( convex_hull + 0, convex_hull + n_convex_hull_points, p, Point::R()) != ON_BOUNDED_SIDE)
-				{
-					iter_points[ 1-cur_iter].push_back( p);
+		if ( options.streaming)
+			discard_pruned_points( n_alive);
+
+		survivors.clear();
+		survivor_x.clear();
+		survivor_y.clear();
+	}
+	
+		
+	// move points[ i] to the front of the point array, shifting the
+	// points before it by one
+	inline void
+		move_to_front ( std::size_t i)
+	{
+		if ( i == 0)
+			return;
+		make_view_order();
+		if ( view_points == 0)
+			std::rotate( points.begin(), points.begin() + i, points.begin() + i+1);
+		else
+			std::rotate( view_order.begin(), view_order.begin() + i, view_order.begin() + i+1);
+		std::rotate( point_x.begin(), point_x.begin() + i, point_x.begin() + i+1);
+		std::rotate( point_y.begin(), point_y.begin() + i, point_y.begin() + i+1);
+
+		for ( int k = 0; k < n_support_points; ++k)
+			if ( support_ids[ k] == i)
+				support_ids[ k] = 0;
+			else if ( support_ids[ k] < i)
+				++support_ids[ k];
+
+		// the memo is keyed by indices, which have changed
+		for ( std::size_t j = 0; j < memo.size(); ++j)
+			memo[ j].n = -1;
+	}
+
+	// one pivoting sweep: update the ellipse with the point that violates
+	// it most, as far as the filtered conic tells; points only the exact
+	// predicate can classify are considered if no other violator exists.
+	// Returns false if there was no violator.
+	inline bool
+		pivoting_pass ( )
+	{
+		signed char sides[ block_size];
+		std::size_t n = point_count(), base, m, k, i, best = n;
+		const double* c = filter.coefficients();
+		double score, best_score = 0;
+		bool exact_best = false;
+
+		for ( base = 0; base < n; base += m)
+		{
+			m = (std::min)( std::size_t( block_size), n - base);
+			filter.side( &point_x[ base], &point_y[ base], m, sides);
 
-					if ( tco.ellipse.has_on_unbounded_side( p))
+			for ( k = 0; k < m; ++k)
+			{
+				i = base + k;
+				if ( sides[ k] > 0)
+				{
+					double x = point_x[ i], y = point_y[ i];
+					score = filter.is_conic()
+						? ( c[ 0]*x + c[ 2]*y + c[ 3])*x + ( c[ 1]*y + c[ 4])*y + c[ 5]
+						: 0;
+					if ( best == n || exact_best || score > best_score)
 					{
-						update_ellipse( p);
-						outlier = true;
-						compute_convex_hull();
+						best = i;
+						best_score = score;
+						exact_best = false;
 					}
 				}
+				else if ( sides[ k] == 0 && best == n
+				          && is_outlier( i, 0))
+				{
+					best = i;
+					exact_best = true;
+				}
 			}
-
-			iter_points[ cur_iter].clear();
-			cur_iter = 1-cur_iter;
 		}
+
+		if ( best == n)
+			return( false);
+		update_ellipse( best);
+		return( true);
 	}
-	
-		
+
 	inline void
     me ( )
     {
-		typename std::list< Point >::iterator last = points.end(), it;
+		signed char sides[ block_size];
+		std::size_t n = point_count(), base, m, k;
 		bool outlier = true;
 
-		n_support_points = 0;
-		tco.ellipse.set();
+		load_coordinates();
+		compute_ellipse();
+		update_filter();
 
 		while ( outlier)
 		{
 			outlier = false;
-			for ( it = points.begin(); it != last; it++)
+			++n_passes;
+			if ( options.parallel)
+			{
+				parallel_plain_pass( outlier);
+				continue;
+			}
+			if ( options.update_strategy == PIVOTING_UPDATES)
 			{
-				const Point& p = *it;
-				if ( tco.ellipse.has_on_unbounded_side( p))
+				outlier = pivoting_pass( );
+				continue;
+			}
+			for ( base = 0; base < n; base += m)
+			{
+				m = (std::min)( std::size_t( block_size), n - base);
+				filter.side( &point_x[ base], &point_y[ base], m, sides);
+
+				for ( k = 0; k < m; ++k)
 				{
-					update_ellipse( p);
-					outlier = true;
+					if ( is_outlier( base + k, sides[ k]))
+					{
+						update_ellipse( base + k);
+						if ( options.update_strategy == MOVE_TO_FRONT_UPDATES)
+							move_to_front( base + k);
+						outlier = true;
+						filter.side( &point_x[ 0] + base+k+1, &point_y[ 0] + base+k+1,
+						             m-k-1, sides+k+1);
+					}
 				}
 			}
 		}
     }
 
+	template < class InputIterator >
+	void
+		construct ( InputIterator first, InputIterator last)
+	{
+		initialize();
+		compute( first, last);
+	}
+
+	// reset the state; every constructor starts with it
+	void
+		initialize ( )
+	{
+		if ( options.streaming)
+			options.use_convex_hull_heuristic = true;
+
+		n_support_points = 0;
+
+		n_convex_hull_points = 0;
+		n_loaded_points = 0;
+		n_pruned_points = 0;
+		n_passes = 0;
+		n_updates = 0;
+		n_prefilter_input = 0;
+		n_prefiltered_points = 0;
+		view_points = 0;
+		n_view_points = 0;
+	}
+
+	// replace the points by the vertices of their convex hull; a view
+	// becomes a copy of the vertices
+	inline void
+		reduce_to_convex_hull ( )
+	{
+		std::size_t n = point_count(), n_chunks = 1, chunk, c;
+		long chunk_index;
+
+		if ( n < 3)
+			return;
+		CGAL_optimisation_precondition( view_order.empty());
+		const Point* data = view_points != 0 ? view_points : &points[ 0];
+		if ( options.parallel)
+			n_chunks = (std::max)( std::size_t( 1), (std::min)(
+				std::size_t( number_of_threads()), n / ( 4 * block_size)));
+		chunk = ( n + n_chunks - 1) / n_chunks;
+		chunk_hulls.resize( n_chunks);
+
+#ifdef _OPENMP
+#pragma omp parallel for schedule( static) num_threads( number_of_threads()) if ( n_chunks > 1)
+#endif
+		for ( chunk_index = 0; chunk_index < long( n_chunks); ++chunk_index)
+		{
+			std::size_t first = chunk_index * chunk;
+			std::size_t last = (std::min)( first + chunk, n);
+			chunk_hulls[ chunk_index].clear();
+			CGAL::ch_akl_toussaint( data + first, data + last,
+			                        std::back_inserter( chunk_hulls[ chunk_index]));
+		}
+
+		hull_points.clear();
+		if ( n_chunks == 1)
+			hull_points.swap( chunk_hulls[ 0]);
+		else
+		{
+			// the hull vertices are among the chunks' hull vertices
+			points.clear();
+			for ( c = 0; c < n_chunks; ++c)
+				points.insert( points.end(), chunk_hulls[ c].begin(), chunk_hulls[ c].end());
+			CGAL::ch_graham_andrew( points.begin(), points.end(),
+			                        std::back_inserter( hull_points));
+		}
+
+		n_pruned_points += n - hull_points.size();
+		points.swap( hull_points);
+		view_points = 0;
+		n_view_points = 0;
+	}
+
+	// store the points and compute their ellipse; all state must be reset
+	template < class InputIterator >
+	void
+		compute ( InputIterator first, InputIterator last)
+	{
+        // range of points not empty?
+        if ( first != last) {    
+            // store points
+            std::copy( first, last, std::back_inserter( points));
+		}
+		solve();
+	}
+
+	// refer to the caller's points and compute their ellipse; all state
+	// must be reset
+	void
+		compute_view ( const Point* first, const Point* last)
+	{
+		CGAL_optimisation_precondition( first <= last);
+		if ( first != last)
+		{
+			view_points = first;
+			n_view_points = last - first;
+		}
+		solve();
+	}
+
+	// make the points ids[ 0, n) the support set, with the ellipse of
+	// these points; the ids are positions in [points_begin(), points_end())
+	void
+		seed_support ( const std::size_t* ids, std::size_t n)
+	{
+		std::vector< Point> seeds;
+		std::size_t i;
+		int j;
+
+		seeds.reserve( n);
+		for ( i = 0; i < n; ++i)
+			seeds.push_back( point( ids[ i]));
+		Min_ellipse_2_rublev<Traits_> seed( seeds.begin(), seeds.end(), true, tco);
+
+		n_support_points = seed.number_of_support_points();
+		for ( j = 0; j < n_support_points; ++j)
+		{
+			support_ids[ j] = ids[ seed.support_point_index( j)];
+			support_points[ j] = point( support_ids[ j]);
+		}
+	}
+
+	// warm start: seed the support set with the points nearest to the
+	// hints, as far as double precision tells; the seed is a subset of the
+	// points, so the result does not depend on the hints
+	void
+		seed_from_hints ( )
+	{
+		const std::size_t n = point_count();
+		const int n_hints = int( hint_points.size());
+		std::vector< double> hx( n_hints), hy( n_hints), best_distance( n_hints, HUGE_VAL);
+		std::vector< std::size_t> best( n_hints, n);
+		int k;
+
+		if ( n == 0)
+			return;
+		load_coordinates();
+		for ( k = 0; k < n_hints; ++k)
+		{
+			hx[ k] = CGAL::to_double( hint_points[ k].x());
+			hy[ k] = CGAL::to_double( hint_points[ k].y());
+		}
+
+		// nearest point to every hint, the first one on ties
+#ifdef _OPENMP
+#pragma omp parallel num_threads( number_of_threads()) if ( options.parallel)
+#endif
+		{
+			std::vector< double> distance( n_hints, HUGE_VAL);
+			std::vector< std::size_t> index( n_hints, n);
+			long j;
+			int h;
+
+#ifdef _OPENMP
+#pragma omp for schedule( static) nowait
+#endif
+			for ( j = 0; j < long( n); ++j)
+				for ( h = 0; h < n_hints; ++h)
+				{
+					double dx = point_x[ j] - hx[ h], dy = point_y[ j] - hy[ h];
+					double d = dx * dx + dy * dy;
+					if ( d < distance[ h])
+					{
+						distance[ h] = d;
+						index[ h] = j;
+					}
+				}
+#ifdef _OPENMP
+#pragma omp critical
+#endif
+			for ( h = 0; h < n_hints; ++h)
+				if ( distance[ h] < best_distance[ h] ||
+				     ( distance[ h] == best_distance[ h] && index[ h] < best[ h]))
+				{
+					best_distance[ h] = distance[ h];
+					best[ h] = index[ h];
+				}
+		}
+
+		std::sort( best.begin(), best.end());
+		best.erase( std::unique( best.begin(), best.end()), best.end());
+		best.erase( std::remove( best.begin(), best.end(), n), best.end());
+		if ( !best.empty())
+			seed_support( &best[ 0], best.size());
+	}
+
+	// divide and conquer: solve contiguous chunks of the points in
+	// parallel and seed the support set with the union of theirs
+	void
+		seed_from_chunks ( )
+	{
+		const std::size_t n = point_count();
+		std::size_t n_chunks = (std::min)( std::size_t( number_of_threads()),
+		                                   n / ( 4 * block_size));
+		if ( n_chunks < 2)
+			return;
+		const std::size_t chunk = ( n + n_chunks - 1) / n_chunks;
+
+		// the chunks are solved sequentially and in order, so that the
+		// support indices refer to positions in the chunk
+		Options chunk_options = options;
+		chunk_options.parallel = false;
+		chunk_options.streaming = false;
+		chunk_options.hull_first = false;
+		chunk_options.random_permutation = false;
+		chunk_options.divide_and_conquer = false;
+		if ( chunk_options.update_strategy == MOVE_TO_FRONT_UPDATES)
+			chunk_options.update_strategy = RESTART_UPDATES;
+
+		// a view with its own order is not contiguous; its chunks are copied
+		const Point* data = view_points == 0 ? &points[ 0]
+		                  : view_order.empty() ? view_points : 0;
+		std::vector< std::size_t> ids( 5 * n_chunks, n);
+		long chunk_index;
+
+#ifdef _OPENMP
+#pragma omp parallel for schedule( static) num_threads( number_of_threads())
+#endif
+		for ( chunk_index = 0; chunk_index < long( n_chunks); ++chunk_index)
+		{
+			std::size_t first = chunk_index * chunk;
+			std::size_t last = (std::min)( first + chunk, n);
+			Min_ellipse_2_rublev<Traits_> solver( chunk_options, tco);
+			if ( data != 0)
+				solver.assign_view( data + first, data + last);
+			else
+				solver.assign( points_begin() + first, points_begin() + last);
+			for ( int j = 0; j < solver.number_of_support_points(); ++j)
+				ids[ 5 * chunk_index + j] = first + solver.support_point_index( j);
+		}
+
+		ids.erase( std::remove( ids.begin(), ids.end(), n), ids.end());
+		seed_support( &ids[ 0], ids.size());
+	}
+
+	// compute the ellipse of the stored or viewed points
+	void
+		solve ( )
+	{
+		if ( options.hull_first)
+			reduce_to_convex_hull();
+
+		// the hull vertices come in order around the hull, in which almost
+		// every point is outside the ellipse of its predecessors
+		if ( options.random_permutation || options.hull_first)
+		{
+			CGAL::Random random( options.random_seed);
+			make_view_order();
+			for ( std::size_t i = point_count(); i > 1; --i)
+				swap_points( i-1, random.get_int( 0, int( i)));
+		}
+
+		if ( !hint_points.empty())
+		{
+			seed_from_hints();
+			hint_points.clear();
+		}
+		else if ( options.divide_and_conquer)
+			seed_from_chunks();
+
+        // compute me
+		if ( options.use_convex_hull_heuristic)
+		{
+			me_with_convex_hull_heuristic( );
+		}
+		else
+		{
+			me( );
+		}
+	}
+
   public:
     // Constructors
     // ------------
@@ -337,46 +1622,78 @@ class Min_ellipse_2_rublev {
                    const Traits& traits    = Traits())
             : tco( traits)
         {
-			this->use_convex_hull_heuristic = use_convex_hull_heuristic;
+			options.use_convex_hull_heuristic = use_convex_hull_heuristic;
+			construct( first, last);
+        }
 
-            // allocate support points' array
-            support_points = new Point[ 5];
-			n_support_points = 0;
+    // STL-like constructor with explicit solver options
+    template < class InputIterator >
+    Min_ellipse_2_rublev( InputIterator first,
+                   InputIterator last,
+				   const Options& solver_options,
+                   const Traits& traits    = Traits())
+            : tco( traits), options( solver_options)
+        {
+			construct( first, last);
+        }
 
-			convex_hull = new Point[ 5];
-			n_convex_hull_points = 0;
-    
-            // range of points not empty?
-            if ( first != last) {    
-                // store points
-                std::copy( first, last, std::back_inserter( points));
-			}
-    
-            // compute me
-			if ( use_convex_hull_heuristic)
-			{
-				me_with_convex_hull_heuristic( );
-			}
-			else
-			{
-				me( );
-			}
+    // view constructor: solve over the caller's points [first, last)
+    // instead of a copy of them. Only an index permutation is kept, and
+    // only once the points are permuted (random permutation, move-to-front
+    // or streaming); points_begin() and points_end() then traverse the
+    // caller's points in the solver's order. The points must neither
+    // change nor go away while the solver refers to them, i.e. until
+    // clear(), assign() or insert(), which copy them first, or hull first
+    // mode, which keeps a copy of the hull vertices only.
+    Min_ellipse_2_rublev( const Point* first,
+                   const Point* last,
+                   View_tag,
+                   const Options& solver_options = Options(),
+                   const Traits& traits = Traits())
+            : tco( traits), options( solver_options)
+        {
+			initialize();
+			compute_view( first, last);
+        }
+
+    // warm start constructor: as above, but the computation starts from
+    // the input points nearest to the hint points [hints_first,
+    // hints_last), e.g. the support points of a similar point set. The
+    // hints only affect the running time, and a few of them suffice.
+    template < class InputIterator, class HintIterator >
+    Min_ellipse_2_rublev( InputIterator first,
+                   InputIterator last,
+                   HintIterator hints_first,
+                   HintIterator hints_last,
+                   const Options& solver_options,
+                   const Traits& traits    = Traits())
+            : tco( traits), options( solver_options),
+              hint_points( hints_first, hints_last)
+        {
+			construct( first, last);
+        }
+
+    // constructor for an empty set with explicit solver options, e.g. to
+    // feed a stream of points to insert()
+    explicit
+    Min_ellipse_2_rublev( const Options& solver_options,
+                   const Traits& traits = Traits())
+            : tco( traits), options( solver_options)
+        {
+			construct( static_cast< const Point*>( 0),
+			           static_cast< const Point*>( 0));
         }
 
     // default constructor
     inline
     Min_ellipse_2_rublev( const Traits& traits = Traits())
-        : tco( traits), use_convex_hull_heuristic( true)
+        : tco( traits)
     {
-        // allocate support points' array
-        support_points = new Point[ 5];
-		n_support_points = 0;
-
-		convex_hull = new Point[ 5];
-		n_convex_hull_points = 0;
+		initialize();
     
         // initialize ellipse
-        tco.ellipse.set();
+        current_ellipse.set();
+        update_filter();
     
         CGAL_optimisation_postcondition( is_empty());
     }
@@ -384,16 +1701,16 @@ class Min_ellipse_2_rublev {
     // constructor for one point
     inline
     Min_ellipse_2_rublev( const Point& p, const Traits& traits = Traits())
-        : tco( traits), points( 1, p), use_convex_hull_heuristic( true)
+        : tco( traits), points( 1, p)
     {
-        // allocate support points' array
-        support_points = new Point[ 5];
-		convex_hull = new Point[ 5];
+		initialize();
     
         // initialize ellipse
 		n_support_points = 1;
         support_points[ 0] = p;
-        tco.ellipse.set( p);
+        support_ids[ 0] = 0;
+        current_ellipse.set( p);
+        update_filter();
 
 		n_convex_hull_points = 1;
 		convex_hull[ 0] = p;
@@ -407,14 +1724,9 @@ class Min_ellipse_2_rublev {
     inline
     Min_ellipse_2_rublev( Point p1, Point p2,
                    const Traits& traits = Traits())
-        : tco( traits), use_convex_hull_heuristic( true)
+        : tco( traits)
     {
-        // allocate support points' array
-        support_points = new Point[ 5];
-		n_support_points = 0;
-
-		convex_hull = new Point[ 5];
-		n_convex_hull_points = 0;
+		initialize();
     
         // store points
         points.push_back( p1);
@@ -430,14 +1742,9 @@ class Min_ellipse_2_rublev {
     inline
     Min_ellipse_2_rublev( const Point& p1, const Point& p2, const Point& p3,
                    const Traits& traits = Traits())
-        : tco( traits), use_convex_hull_heuristic( true)
+        : tco( traits)
     {
-        // allocate support points' array
-        support_points = new Point[ 5];
-		n_support_points = 0;
-
-		convex_hull = new Point[ 5];
-		n_convex_hull_points = 0;
+		initialize();
     
         // store points
         points.push_back( p1);
@@ -453,14 +1760,9 @@ class Min_ellipse_2_rublev {
     Min_ellipse_2_rublev( const Point& p1, const Point& p2,
                    const Point& p3, const Point& p4,
                    const Traits& traits = Traits())
-        : tco( traits), use_convex_hull_heuristic( true)
+        : tco( traits)
     {
-        // allocate support points' array
-        support_points = new Point[ 5];
-		n_support_points = 0;
-
-		convex_hull = new Point[ 5];
-		n_convex_hull_points = 0;
+		initialize();
     
         // store points
         points.push_back( p1);
@@ -477,14 +1779,9 @@ class Min_ellipse_2_rublev {
     Min_ellipse_2_rublev( const Point& p1, const Point& p2, const Point& p3,
                    const Point& p4, const Point& p5,
                    const Traits& traits = Traits())
-        : tco( traits), use_convex_hull_heuristic( true)
+        : tco( traits)
     {
-        // allocate support points' array
-        support_points = new Point[ 5];
-		n_support_points = 0;
-
-		convex_hull = new Point[ 5];
-		n_convex_hull_points = 0;
+		initialize();
     
         // store points
         points.push_back( p1);
@@ -498,44 +1795,44 @@ class Min_ellipse_2_rublev {
     }
     
 
-    // Destructor
-    // ----------
-    inline
-    ~Min_ellipse_2_rublev( )
-    {
-        // free support points' array
-        delete[] support_points;
-		delete[] convex_hull;
-    }
-
     // Modifiers
     // ---------
     void
     insert( const Point& p)
     {
-		if ( !use_convex_hull_heuristic)
+		if ( !options.use_convex_hull_heuristic)
 		{
-			use_convex_hull_heuristic = true;
+			options.use_convex_hull_heuristic = true;
 			compute_convex_hull();
 		}
 
-		// p not in current support convex hull?
-		if ( bounded_side_2( convex_hull + 0, convex_hull + n_convex_hull_points, p, Point::R()) != ON_BOUNDED_SIDE)
+		// p not in current support convex hull and not in the ellipse?
+		bool dominated =
+			hull_filter.has_on_bounded_side( CGAL::to_double( p.x()),
+			                                 CGAL::to_double( p.y()))
+			|| is_dominated( p);
+		CGAL_MIN_ELLIPSE_2_RUBLEV_STATISTICS( stats.hull_rejections += dominated);
+		if ( dominated && options.streaming)
 		{
-			if ( has_on_unbounded_side( p))
-			{
-				points.push_front( p);
-				support_points[0] = p;
-				n_support_points = 1;
+			++n_pruned_points;
+			return;
+		}
+		bool outlier = !dominated && has_on_unbounded_side( p);
+		copy_view();
+		if ( outlier)
+		{
+			support_points[ 0] = p;
+			support_ids[ 0] = points.size();
+		}
 
-				me_with_convex_hull_heuristic();
-			}
-				// append p to the end of the list
-				points.push_back( p);
+		// append p to the end of the array
+		points.push_back( p);
+
+		if ( outlier)
+		{
+			n_support_points = 1;
+			me_with_convex_hull_heuristic();
 		}
-		else
-			// append p to the end of the list
-            points.push_back( p);
     }
 
     template < class InputIterator >
@@ -550,12 +1847,99 @@ class Min_ellipse_2_rublev {
     clear( )
     {
         points.erase( points.begin(), points.end());
+		view_order.clear();
         n_support_points = 0;
 		n_convex_hull_points = 0;
 
-        tco.ellipse.set();
+		point_x.clear();
+		point_y.clear();
+		n_loaded_points = 0;
+		n_pruned_points = 0;
+		n_passes = 0;
+		n_updates = 0;
+		n_prefilter_input = 0;
+		n_prefiltered_points = 0;
+		view_points = 0;
+		n_view_points = 0;
+		stats = Statistics();
+		filter.set_range( 0, 0);
+		hull_filter.set( convex_hull, 0);
+		for ( std::size_t i = 0; i < memo.size(); ++i)
+			memo[ i].n = -1;
+
+        current_ellipse.set();
+        update_filter();
     }    
 
+    // make room for n points, so that later computations on up to n
+    // points do not allocate point storage; together with clear() and
+    // assign() the solver serves as a reusable workspace
+    void
+    reserve( std::size_t n)
+    {
+        points.reserve( n);
+        point_x.reserve( n);
+        point_y.reserve( n);
+        survivors.reserve( n);
+        survivor_x.reserve( n);
+        survivor_y.reserve( n);
+    }
+
+    // replace the point set and compute its ellipse; the storage of the
+    // previous computation is reused
+    template < class InputIterator >
+    void
+    assign( InputIterator first, InputIterator last)
+    {
+        clear();
+        compute( first, last);
+    }
+
+    // replace the point set and compute its ellipse, warm started from
+    // the hint points [hints_first, hints_last) as with the warm start
+    // constructor
+    template < class InputIterator, class HintIterator >
+    void
+    resolve( InputIterator first, InputIterator last,
+             HintIterator hints_first, HintIterator hints_last)
+    {
+        std::vector< Point> hints( hints_first, hints_last);
+        clear();
+        hint_points.swap( hints);
+        compute( first, last);
+    }
+
+    // the same with the current support points as the hints, e.g. for the
+    // next frame of a temporally coherent sequence
+    template < class InputIterator >
+    void
+    resolve( InputIterator first, InputIterator last)
+    {
+        resolve( first, last, support_points_begin(), support_points_end());
+    }
+
+    // replace the point set by a view of the caller's points [first,
+    // last), as with the view constructor, and compute its ellipse
+    void
+    assign_view( const Point* first, const Point* last)
+    {
+        clear();
+        compute_view( first, last);
+    }
+
+    // the same, warm started from the hint points [hints_first,
+    // hints_last) as with resolve()
+    template < class HintIterator >
+    void
+    resolve_view( const Point* first, const Point* last,
+                  HintIterator hints_first, HintIterator hints_last)
+    {
+        std::vector< Point> hints( hints_first, hints_last);
+        clear();
+        hint_points.swap( hints);
+        compute_view( first, last);
+    }
+
     // Validity check
     // --------------
     bool
@@ -570,13 +1954,17 @@ class Min_ellipse_2_rublev {
         verr << "  |P| = " << number_of_points()
              << ", |S| = " << number_of_support_points() << endl;
     
+        // the checks use the ellipse itself, not the filters and the
+        // predicate of the in-ellipse tests above, so that they also
+        // validate those
+
         // containment check (a)
         verr << "  a) containment check..." << flush;
         Point_iterator point_iter;
         for ( point_iter  = points_begin();
               point_iter != points_end();
               ++point_iter)
-            if ( has_on_unbounded_side( *point_iter))
+            if ( current_ellipse.has_on_unbounded_side( *point_iter))
                 return( CGAL::_optimisation_is_valid_fail( verr,
                             "ellipse does not contain all points"));
         verr << "passed." << endl;
@@ -589,7 +1977,7 @@ class Min_ellipse_2_rublev {
         for ( support_point_iter  = support_points_begin();
               support_point_iter != support_points_end();
               ++support_point_iter)
-            if ( ! has_on_boundary( *support_point_iter))
+            if ( ! current_ellipse.has_on_boundary( *support_point_iter))
                 return( CGAL::_optimisation_is_valid_fail( verr,
                             "ellipse does not have all \
                              support points on the boundary"));
@@ -611,7 +1999,7 @@ class Min_ellipse_2_rublev {
 
 //TODO: IO functions needs to be added
 
-CGAL_END_NAMESPACE
+} //namespace CGAL
 
 #endif // CGAL_MIN_ELLIPSE_2_RUBLEV_H
 
@@ -0,0 +1,156 @@
+#ifndef CGAL_MIN_ELLIPSE_2_RUBLEV_BATCH_H
+#define CGAL_MIN_ELLIPSE_2_RUBLEV_BATCH_H
+
+#include <CGAL/Optimisation/basic.h>
+#include <vector>
+#include <cstddef>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+#include "Min_ellipse_2_rublev.h"
+
+namespace CGAL {
+
+// Batched min ellipse for many independent point sets
+// ===================================================
+// The sets are given in compressed sparse row layout: one flat array of
+// points and n+1 offsets, set i being points[ offsets[ i], offsets[ i+1]).
+// The sets are handed out to the threads in small chunks on demand
+// (OpenMP dynamic scheduling), so a thread that finishes its sets early
+// takes over work the others have not started. Every thread owns one
+// Min_ellipse_2_rublev and reuses its storage for all its sets via
+// assign().
+//
+// The results are stored compactly: one ellipse per set and five support
+// point slots per set, holding indices into the flat point array.
+template < class Traits_ >
+class Min_ellipse_2_rublev_batch;
+
+template < class Traits_ >
+class Min_ellipse_2_rublev_batch {
+  public:
+    // types
+    typedef           Traits_                           Traits;
+    typedef typename  Traits_::Point                    Point;
+    typedef typename  Traits_::Ellipse                  Ellipse;
+    typedef           Min_ellipse_2_rublev< Traits_ >   Solver;
+    typedef typename  Solver::Options                   Options;
+
+  private:
+    // private data members
+    std::vector< Ellipse>      ellipses;        // one per set
+    std::vector< std::size_t>  support;         // 5 slots per set
+    std::vector< int>          n_support;       // support points per set
+
+    // copying and assignment not allowed!
+    Min_ellipse_2_rublev_batch( const Min_ellipse_2_rublev_batch<Traits_>&);
+    Min_ellipse_2_rublev_batch<Traits_>& operator = ( const Min_ellipse_2_rublev_batch<Traits_>&);
+
+// ============================================================================
+
+// Class implementation
+// ====================
+
+  public:
+    // Constructor
+    // -----------
+    // Solves the sets [ offsets_first, offsets_last) describes on n_threads
+    // threads (0: as many as OpenMP offers). The solver options apply to
+    // every set, except that sets are always solved sequentially, in input
+    // order and without streaming, hull first or divide and conquer mode,
+    // so that the support indices refer to the input.
+    template < class RandomAccessIterator, class OffsetIterator >
+    Min_ellipse_2_rublev_batch( RandomAccessIterator points,
+                                OffsetIterator offsets_first,
+                                OffsetIterator offsets_last,
+                                const Options& solver_options = Options(),
+                                int n_threads = 0,
+                                const Traits& traits = Traits())
+    {
+        CGAL_optimisation_precondition( offsets_first != offsets_last);
+        const std::ptrdiff_t n_sets = ( offsets_last - offsets_first) - 1;
+
+        Options options = solver_options;
+        options.parallel = false;
+        options.streaming = false;
+        options.hull_first = false;
+        options.random_permutation = false;
+        options.divide_and_conquer = false;
+        if ( options.update_strategy == Solver::MOVE_TO_FRONT_UPDATES)
+            options.update_strategy = Solver::RESTART_UPDATES;
+
+        ellipses.resize( n_sets);
+        support.resize( 5 * n_sets);
+        n_support.resize( n_sets);
+
+#ifdef _OPENMP
+        if ( n_threads <= 0)
+            n_threads = omp_get_max_threads();
+        #pragma omp parallel num_threads( n_threads)
+#endif
+        {
+            // per thread scratch space
+            Solver solver( options, traits);
+
+#ifdef _OPENMP
+            #pragma omp for schedule( dynamic, 16)
+#endif
+            for ( std::ptrdiff_t i = 0; i < n_sets; ++i)
+            {
+                std::size_t first = offsets_first[ i];
+                std::size_t last = offsets_first[ i+1];
+                solver.assign( points + first, points + last);
+
+                ellipses[ i] = solver.ellipse();
+                n_support[ i] = solver.number_of_support_points();
+                for ( int j = 0; j < n_support[ i]; ++j)
+                    support[ 5*i + j] = first + solver.support_point_index( j);
+            }
+        }
+#ifndef _OPENMP
+        (void)n_threads;
+#endif
+    }
+
+    // Access functions
+    // ----------------
+    inline
+    std::size_t
+    number_of_sets( ) const
+    {
+        return( ellipses.size());
+    }
+
+    inline
+    const Ellipse&
+    ellipse( std::size_t i) const
+    {
+        CGAL_optimisation_precondition( i < number_of_sets());
+        return( ellipses[ i]);
+    }
+
+    inline
+    int
+    number_of_support_points( std::size_t i) const
+    {
+        CGAL_optimisation_precondition( i < number_of_sets());
+        return( n_support[ i]);
+    }
+
+    // index into the flat point array of support point j of set i
+    inline
+    std::size_t
+    support_point_index( std::size_t i, int j) const
+    {
+        CGAL_optimisation_precondition( ( j >= 0) &&
+                                        ( j < number_of_support_points( i)));
+        return( support[ 5*i + j]);
+    }
+};
+
+} //namespace CGAL
+
+#endif // CGAL_MIN_ELLIPSE_2_RUBLEV_BATCH_H
+
+// ===== EOF =================================================================
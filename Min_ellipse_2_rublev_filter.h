@@ -0,0 +1,478 @@
+#ifndef CGAL_MIN_ELLIPSE_2_RUBLEV_FILTER_H
+#define CGAL_MIN_ELLIPSE_2_RUBLEV_FILTER_H
+
+#include <CGAL/Optimisation/basic.h>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <cstddef>
+
+#if defined( __AVX512F__)
+#  define CGAL_MIN_ELLIPSE_2_RUBLEV_AVX512
+#  include <immintrin.h>
+#elif defined( __AVX2__) && ( defined( __FMA__) || defined( _MSC_VER))
+#  define CGAL_MIN_ELLIPSE_2_RUBLEV_AVX2
+#  include <immintrin.h>
+#endif
+
+#include "Min_ellipse_2_rublev_predicate.h"
+
+namespace CGAL {
+
+template < class Traits_ >
+class Min_ellipse_2_rublev_hull_filter;
+
+// Semi-static floating-point filter for the in-ellipse test
+// =========================================================
+// The ellipse spanned by the support points is rebuilt as an explicit conic
+//
+//   r x^2 + s y^2 + t xy + u x + v y + w,   negative inside,
+//
+// from exact coefficients rounded to double. For every point inside the
+// range given by set_range() the evaluated conic differs from the exact one
+// by at most 'bound', so side() either certifies the answer of
+// Ellipse::has_on_unbounded_side() or returns 0 and the caller has to fall
+// back to the exact predicate. Only the 0, 1, 2, 3 and 5 point ellipses are
+// filtered; the 4 point ellipse is not a single conic and is always
+// reported as uncertain, Min_ellipse_2_rublev_predicate filters it.
+//
+// The batched side() classifies blocks of points stored as separate x and y
+// arrays; it uses AVX-512 or AVX2/FMA when the translation unit is compiled
+// for it and a scalar loop otherwise. Given a hull filter it runs the
+// domination test first and evaluates the conic only for the points which
+// are not certainly inside the support hull.
+template < class Traits_ >
+class Min_ellipse_2_rublev_filter {
+  public:
+    // types
+    typedef typename  Traits_::Point                    Point;
+    typedef typename  Traits_::K::FT                    FT;
+    typedef           Min_ellipse_2_rublev_hull_filter< Traits_ >  Hull_filter;
+
+    // side of a point certainly in the interior of the support hull
+    enum { dominated = 2 };
+
+  private:
+    // private data members
+    int          n_support_points;              // number of support points
+    bool         has_conic;                     // c[] and bound are valid
+    double       c[ 6];                         // r, s, t, u, v, w
+    double       box[ 4];                       // bbox of 1 or 2 support points
+    double       max_x, max_y;                  // range of filtered points
+    double       bound;                         // error bound of c[]
+
+    // 2^-48: covers the rounding of the exact coefficients and coordinates
+    // (at most 1 ulp each) and of the evaluation, with plenty of slack
+    static double relative_error( ) { return 3.5527136788005009e-15; }
+
+// ============================================================================
+
+// Class implementation
+// ====================
+
+  public:
+    Min_ellipse_2_rublev_filter( )
+        : n_support_points( 0), has_conic( false),
+          max_x( 0), max_y( 0), bound( 0)
+    { }
+
+    // all filtered points have to satisfy |x| <= max_abs_x, |y| <= max_abs_y
+    void
+    set_range( double max_abs_x, double max_abs_y)
+    {
+        max_x = max_abs_x;
+        max_y = max_abs_y;
+        compute_bound();
+    }
+
+    double range_x( ) const { return( max_x); }
+    double range_y( ) const { return( max_y); }
+
+    // rebuild the filter for the ellipse through the given support points
+    void
+    set( const Point* support, int n)
+    {
+        n_support_points = n;
+        has_conic = false;
+
+        switch ( n) {
+          case 5: {
+            FT exact[ 6];
+            has_conic = Min_ellipse_2_rublev_predicate< Traits_>::
+                conic_through_five_points( support, exact) && store( exact);
+            break;
+          }
+          case 3:
+            has_conic = steiner_ellipse( support);
+            break;
+          case 2:
+          case 1:
+            box[ 0] = box[ 1] = CGAL::to_double( support[ 0].x());
+            box[ 2] = box[ 3] = CGAL::to_double( support[ 0].y());
+            for ( int i = 1; i < n; ++i) {
+                box[ 0] = (std::min)( box[ 0], CGAL::to_double( support[ i].x()));
+                box[ 1] = (std::max)( box[ 1], CGAL::to_double( support[ i].x()));
+                box[ 2] = (std::min)( box[ 2], CGAL::to_double( support[ i].y()));
+                box[ 3] = (std::max)( box[ 3], CGAL::to_double( support[ i].y()));
+            }
+            break;
+          default:
+            break;
+        }
+        compute_bound();
+    }
+
+    // -1: certainly on the bounded side, 1: certainly on the unbounded
+    // side, 0: uncertain
+    inline
+    int
+    side( double x, double y) const
+    {
+        switch ( n_support_points) {
+          case 0:
+            return( 1);
+          case 1:
+          case 2:
+            // to_double() is monotone, so leaving the bbox of the rounded
+            // support points means leaving the exact segment
+            return( ( x < box[ 0] || x > box[ 1] ||
+                      y < box[ 2] || y > box[ 3]) ? 1 : 0);
+          default:
+            break;
+        }
+        if ( !has_conic ||
+             std::fabs( x) > max_x || std::fabs( y) > max_y)
+            return( 0);
+
+        double value = ( c[ 0] * x + c[ 2] * y + c[ 3]) * x
+                     + ( c[ 1] * y + c[ 4]) * y + c[ 5];
+        if ( value >  bound) return(  1);
+        if ( value < -bound) return( -1);
+        return( 0);
+    }
+
+    // side() preceded by the domination test: dominated if (x, y) is
+    // certainly in the interior of the hull
+    inline
+    int
+    side( double x, double y, const Hull_filter& hull) const
+    {
+        return( hull.has_on_bounded_side( x, y) ? int( dominated) : side( x, y));
+    }
+
+    // batched side(): sides[ i] = side( x[ i], y[ i]), i in [0, n)
+    void
+    side( const double* x, const double* y, std::size_t n,
+          signed char* sides) const
+    {
+        std::size_t i = 0;
+
+        if ( n_support_points > 2 && has_conic) {
+#if defined( CGAL_MIN_ELLIPSE_2_RUBLEV_AVX512)
+            i = side_avx512( x, y, n, 0, sides);
+#elif defined( CGAL_MIN_ELLIPSE_2_RUBLEV_AVX2)
+            i = side_avx2( x, y, n, 0, sides);
+#endif
+        }
+        for ( ; i < n; ++i)
+            sides[ i] = static_cast<signed char>( side( x[ i], y[ i]));
+    }
+
+    // batched side() with domination test: sides[ i] = side( x[ i], y[ i],
+    // hull), i in [0, n)
+    void
+    side( const double* x, const double* y, std::size_t n,
+          const Hull_filter& hull, signed char* sides) const
+    {
+        std::size_t i = 0;
+
+        if ( n_support_points > 2 && ( has_conic || hull.number_of_edges() > 0)) {
+#if defined( CGAL_MIN_ELLIPSE_2_RUBLEV_AVX512)
+            i = side_avx512( x, y, n, &hull, sides);
+#elif defined( CGAL_MIN_ELLIPSE_2_RUBLEV_AVX2)
+            i = side_avx2( x, y, n, &hull, sides);
+#endif
+        }
+        for ( ; i < n; ++i)
+            sides[ i] = static_cast<signed char>( side( x[ i], y[ i], hull));
+    }
+
+    // raw access for batched evaluation
+    bool          is_conic( ) const { return( has_conic); }
+    const double* coefficients( ) const { return( c); }
+    double        error_bound( ) const { return( bound); }
+
+  private:
+#if defined( CGAL_MIN_ELLIPSE_2_RUBLEV_AVX512)
+    // the conic is only evaluated if has_conic is set, the domination
+    // test only if hull is given
+    std::size_t
+    side_avx512( const double* x, const double* y, std::size_t n,
+                 const Hull_filter* hull, signed char* sides) const
+    {
+        const __m512d r = _mm512_set1_pd( c[ 0]), s = _mm512_set1_pd( c[ 1]),
+                      t = _mm512_set1_pd( c[ 2]), u = _mm512_set1_pd( c[ 3]),
+                      v = _mm512_set1_pd( c[ 4]), w = _mm512_set1_pd( c[ 5]);
+        const __m512d b = _mm512_set1_pd( bound), nb = _mm512_set1_pd( -bound);
+        const __m512d mx = _mm512_set1_pd( max_x), my = _mm512_set1_pd( max_y);
+        const int n_edges = hull != 0 ? hull->number_of_edges() : 0;
+        const double* e = hull != 0 ? hull->edges() : 0;
+        const double* eb = hull != 0 ? hull->error_bounds() : 0;
+        const __m512d hx = _mm512_set1_pd( hull != 0 ? hull->range_x() : 0),
+                      hy = _mm512_set1_pd( hull != 0 ? hull->range_y() : 0);
+        std::size_t i = 0;
+
+        for ( ; i + 8 <= n; i += 8) {
+            __m512d px = _mm512_loadu_pd( x + i), py = _mm512_loadu_pd( y + i);
+            unsigned out = 0, in = 0, dom = 0;
+            if ( n_edges > 0) {
+                __mmask8 inside =
+                    _mm512_cmp_pd_mask( _mm512_abs_pd( px), hx, _CMP_LE_OQ) &
+                    _mm512_cmp_pd_mask( _mm512_abs_pd( py), hy, _CMP_LE_OQ);
+                for ( int j = 0; j < n_edges && inside; ++j) {
+                    __m512d a = _mm512_fmadd_pd( _mm512_set1_pd( e[ 3*j]), px,
+                                _mm512_fmadd_pd( _mm512_set1_pd( e[ 3*j+1]), py,
+                                                 _mm512_set1_pd( e[ 3*j+2])));
+                    inside &= _mm512_cmp_pd_mask( a, _mm512_set1_pd( eb[ j]), _CMP_GT_OQ);
+                }
+                dom = inside;
+            }
+            if ( has_conic && dom != 0xff) {
+                __m512d q = _mm512_mul_pd( _mm512_fmadd_pd( r, px,
+                                           _mm512_fmadd_pd( t, py, u)), px);
+                q = _mm512_fmadd_pd( _mm512_fmadd_pd( s, py, v), py, q);
+                q = _mm512_add_pd( q, w);
+                __mmask8 in_range =
+                    _mm512_cmp_pd_mask( _mm512_abs_pd( px), mx, _CMP_LE_OQ) &
+                    _mm512_cmp_pd_mask( _mm512_abs_pd( py), my, _CMP_LE_OQ);
+                out = in_range & _mm512_cmp_pd_mask( q, b, _CMP_GT_OQ);
+                in  = in_range & _mm512_cmp_pd_mask( q, nb, _CMP_LT_OQ);
+            }
+            for ( int k = 0; k < 8; ++k)
+                sides[ i+k] = static_cast<signed char>( ( ( dom >> k) & 1)
+                    ? int( dominated) : int( ( out >> k) & 1) - int( ( in >> k) & 1));
+        }
+        return( i);
+    }
+#endif
+
+#if defined( CGAL_MIN_ELLIPSE_2_RUBLEV_AVX2)
+    std::size_t
+    side_avx2( const double* x, const double* y, std::size_t n,
+               const Hull_filter* hull, signed char* sides) const
+    {
+        const __m256d r = _mm256_set1_pd( c[ 0]), s = _mm256_set1_pd( c[ 1]),
+                      t = _mm256_set1_pd( c[ 2]), u = _mm256_set1_pd( c[ 3]),
+                      v = _mm256_set1_pd( c[ 4]), w = _mm256_set1_pd( c[ 5]);
+        const __m256d b = _mm256_set1_pd( bound), nb = _mm256_set1_pd( -bound);
+        const __m256d mx = _mm256_set1_pd( max_x), my = _mm256_set1_pd( max_y);
+        const __m256d abs_mask = _mm256_castsi256_pd(
+            _mm256_set1_epi64x( 0x7fffffffffffffffLL));
+        const int n_edges = hull != 0 ? hull->number_of_edges() : 0;
+        const double* e = hull != 0 ? hull->edges() : 0;
+        const double* eb = hull != 0 ? hull->error_bounds() : 0;
+        const __m256d hx = _mm256_set1_pd( hull != 0 ? hull->range_x() : 0),
+                      hy = _mm256_set1_pd( hull != 0 ? hull->range_y() : 0);
+        std::size_t i = 0;
+
+        for ( ; i + 4 <= n; i += 4) {
+            __m256d px = _mm256_loadu_pd( x + i), py = _mm256_loadu_pd( y + i);
+            __m256d ax = _mm256_and_pd( px, abs_mask), ay = _mm256_and_pd( py, abs_mask);
+            int out = 0, in = 0, dom = 0;
+            if ( n_edges > 0) {
+                __m256d inside = _mm256_and_pd( _mm256_cmp_pd( ax, hx, _CMP_LE_OQ),
+                                                _mm256_cmp_pd( ay, hy, _CMP_LE_OQ));
+                for ( int j = 0; j < n_edges; ++j) {
+                    __m256d a = _mm256_fmadd_pd( _mm256_set1_pd( e[ 3*j]), px,
+                                _mm256_fmadd_pd( _mm256_set1_pd( e[ 3*j+1]), py,
+                                                 _mm256_set1_pd( e[ 3*j+2])));
+                    inside = _mm256_and_pd( inside,
+                        _mm256_cmp_pd( a, _mm256_set1_pd( eb[ j]), _CMP_GT_OQ));
+                }
+                dom = _mm256_movemask_pd( inside);
+            }
+            if ( has_conic && dom != 0xf) {
+                __m256d q = _mm256_mul_pd( _mm256_fmadd_pd( r, px,
+                                           _mm256_fmadd_pd( t, py, u)), px);
+                q = _mm256_fmadd_pd( _mm256_fmadd_pd( s, py, v), py, q);
+                q = _mm256_add_pd( q, w);
+                __m256d in_range = _mm256_and_pd( _mm256_cmp_pd( ax, mx, _CMP_LE_OQ),
+                                                  _mm256_cmp_pd( ay, my, _CMP_LE_OQ));
+                out = _mm256_movemask_pd( _mm256_and_pd( in_range,
+                          _mm256_cmp_pd( q, b, _CMP_GT_OQ)));
+                in  = _mm256_movemask_pd( _mm256_and_pd( in_range,
+                          _mm256_cmp_pd( q, nb, _CMP_LT_OQ)));
+            }
+            for ( int k = 0; k < 4; ++k)
+                sides[ i+k] = static_cast<signed char>( ( ( dom >> k) & 1)
+                    ? int( dominated) : ( ( out >> k) & 1) - ( ( in >> k) & 1));
+        }
+        return( i);
+    }
+#endif
+
+    void
+    compute_bound( )
+    {
+        if ( !has_conic) return;
+
+        double m = std::fabs( c[ 0]) * max_x * max_x
+                 + std::fabs( c[ 1]) * max_y * max_y
+                 + std::fabs( c[ 2]) * max_x * max_y
+                 + std::fabs( c[ 3]) * max_x
+                 + std::fabs( c[ 4]) * max_y
+                 + std::fabs( c[ 5]);
+
+        // tiny absolute term for underflow in the evaluation
+        bound = m * relative_error() + (std::numeric_limits<double>::min)();
+
+        if ( !( bound < (std::numeric_limits<double>::max)()))
+            has_conic = false;
+    }
+
+    bool
+    store( const FT* exact)
+    {
+        for ( int i = 0; i < 6; ++i) {
+            c[ i] = CGAL::to_double( exact[ i]);
+            if ( !( std::fabs( c[ i]) <= (std::numeric_limits<double>::max)()))
+                return( false);
+        }
+        return( true);
+    }
+
+    // smallest ellipse through three points: centered at the centroid with
+    // (x-c)^T adj(S) (x-c) = 2/3 det(S), S the scatter matrix of the points
+    bool
+    steiner_ellipse( const Point* p)
+    {
+        FT cx = ( p[ 0].x() + p[ 1].x() + p[ 2].x()) / FT( 3);
+        FT cy = ( p[ 0].y() + p[ 1].y() + p[ 2].y()) / FT( 3);
+        FT sxx( 0), sxy( 0), syy( 0);
+        for ( int i = 0; i < 3; ++i) {
+            FT dx = p[ i].x() - cx, dy = p[ i].y() - cy;
+            sxx += dx * dx;
+            sxy += dx * dy;
+            syy += dy * dy;
+        }
+        FT det = sxx * syy - sxy * sxy;
+        if ( CGAL_NTS sign( det) != POSITIVE) return( false);
+
+        FT exact[ 6];
+        exact[ 0] = syy;
+        exact[ 1] = sxx;
+        exact[ 2] = FT( -2) * sxy;
+        exact[ 3] = FT( 2) * ( sxy * cy - syy * cx);
+        exact[ 4] = FT( 2) * ( sxy * cx - sxx * cy);
+        exact[ 5] = syy * cx * cx + sxx * cy * cy - FT( 2) * sxy * cx * cy
+                  - FT( 2) * det / FT( 3);
+        return( store( exact));
+    }
+};
+
+// Floating-point filter for the support hull domination test
+// ===========================================================
+// Keeps the edge equations A x + B y + C of the convex hull of the support
+// points, computed exactly and rounded to double, with one error bound per
+// edge. has_on_bounded_side() only answers true if the point is certainly
+// in the interior of the hull; dropping a point on that answer is always
+// safe, keeping an uncertain one merely costs another test in the next pass.
+template < class Traits_ >
+class Min_ellipse_2_rublev_hull_filter {
+  public:
+    // types
+    typedef typename  Traits_::Point                    Point;
+    typedef typename  Traits_::K::FT                    FT;
+
+    enum { max_edges = 16 };
+
+  private:
+    // private data members
+    int          n_edges;                       // 0 if the hull is degenerate
+    double       e[ max_edges][ 3];             // A, B, C, positive inside
+    double       bound[ max_edges];             // error bounds of e[]
+    double       max_x, max_y;                  // range of filtered points
+
+    static double relative_error( ) { return 3.5527136788005009e-15; }
+
+  public:
+    Min_ellipse_2_rublev_hull_filter( )
+        : n_edges( 0), max_x( 0), max_y( 0)
+    { }
+
+    void
+    set_range( double max_abs_x, double max_abs_y)
+    {
+        max_x = max_abs_x;
+        max_y = max_abs_y;
+        compute_bounds();
+    }
+
+    // rebuild the filter for the convex polygon hull[ 0, n), n <= max_edges,
+    // given in either orientation
+    void
+    set( const Point* hull, int n)
+    {
+        CGAL_optimisation_precondition( n <= max_edges);
+        n_edges = 0;
+        if ( n < 3) return;
+
+        // make the edges positive on the interior
+        int orient = CGAL_NTS sign(
+            ( hull[ 1].x() - hull[ 0].x()) * ( hull[ 2].y() - hull[ 0].y()) -
+            ( hull[ 1].y() - hull[ 0].y()) * ( hull[ 2].x() - hull[ 0].x()));
+        if ( orient == 0) return;
+
+        for ( int i = 0; i < n; ++i) {
+            const Point& a = hull[ i];
+            const Point& b = hull[ ( i+1) % n];
+            FT A = a.y() - b.y(), B = b.x() - a.x(), C = a.x() * b.y() - a.y() * b.x();
+            e[ i][ 0] = orient * CGAL::to_double( A);
+            e[ i][ 1] = orient * CGAL::to_double( B);
+            e[ i][ 2] = orient * CGAL::to_double( C);
+        }
+        n_edges = n;
+        compute_bounds();
+    }
+
+    // true if (x, y) is certainly in the interior of the hull
+    inline
+    bool
+    has_on_bounded_side( double x, double y) const
+    {
+        if ( n_edges == 0 || std::fabs( x) > max_x || std::fabs( y) > max_y)
+            return( false);
+        for ( int i = 0; i < n_edges; ++i)
+            if ( !( e[ i][ 0] * x + e[ i][ 1] * y + e[ i][ 2] > bound[ i]))
+                return( false);
+        return( true);
+    }
+
+    // raw access for batched evaluation: the edge equations A, B, C as
+    // consecutive triples and their error bounds
+    int           number_of_edges( ) const { return( n_edges); }
+    const double* edges( ) const { return( &e[ 0][ 0]); }
+    const double* error_bounds( ) const { return( bound); }
+    double        range_x( ) const { return( max_x); }
+    double        range_y( ) const { return( max_y); }
+
+  private:
+    void
+    compute_bounds( )
+    {
+        for ( int i = 0; i < n_edges; ++i) {
+            bound[ i] = ( std::fabs( e[ i][ 0]) * max_x
+                        + std::fabs( e[ i][ 1]) * max_y
+                        + std::fabs( e[ i][ 2])) * relative_error()
+                      + (std::numeric_limits<double>::min)();
+            if ( !( bound[ i] < (std::numeric_limits<double>::max)()))
+                n_edges = 0;
+        }
+    }
+};
+
+} //namespace CGAL
+
+#endif // CGAL_MIN_ELLIPSE_2_RUBLEV_FILTER_H
+
+// ===== EOF =================================================================
@@ -0,0 +1,161 @@
+#ifndef CGAL_MIN_ELLIPSE_2_RUBLEV_GMP_POOL_H
+#define CGAL_MIN_ELLIPSE_2_RUBLEV_GMP_POOL_H
+
+#include <gmp.h>
+#include <cstddef>
+#include <cstring>
+
+namespace CGAL {
+
+// Per-thread pool for GMP's number storage
+// ========================================
+// The exact constructions of the solvers create and destroy many short
+// lived Gmpq temporaries with limb arrays of a few dozen bytes. install()
+// routes GMP's memory functions through per-thread free lists of blocks
+// of 16, 32, ..., 512 bytes, so that these temporaries are recycled
+// without touching malloc; larger blocks go to the previous memory
+// functions directly. Blocks are obtained from and, beyond a bounded
+// number per list and on thread exit, returned to the previous memory
+// functions, so a counting allocator installed earlier still sees them.
+//
+// GMP only reports the size it asked for, not the size of the block, so
+// install() has to be called before the first GMP number is created, and
+// the pool must stay installed while any number is alive.
+class Min_ellipse_2_rublev_gmp_pool {
+  public:
+    static void
+    install( )
+    {
+        Upstream& u = upstream();
+        mp_get_memory_functions( &u.allocate, &u.reallocate, &u.free);
+        mp_set_memory_functions( &allocate, &reallocate, &deallocate);
+    }
+
+  private:
+    enum { n_classes = 6, max_cached = 1024 };
+
+    struct Upstream {
+        void* (*allocate)( std::size_t);
+        void* (*reallocate)( void*, std::size_t, std::size_t);
+        void  (*free)( void*, std::size_t);
+    };
+
+    struct Free_lists {
+        void* head[ n_classes];
+        int   length[ n_classes];
+
+        Free_lists( )
+        {
+            for ( int c = 0; c < n_classes; ++c) {
+                head[ c] = 0;
+                length[ c] = 0;
+            }
+        }
+
+        ~Free_lists( )
+        {
+            for ( int c = 0; c < n_classes; ++c)
+                while ( head[ c]) {
+                    void* next = *static_cast< void**>( head[ c]);
+                    upstream().free( head[ c], class_size( c));
+                    head[ c] = next;
+                }
+            exited() = true;
+        }
+    };
+
+    static Upstream&
+    upstream( )
+    {
+        static Upstream u;
+        return( u);
+    }
+
+    // set once the thread's free lists are gone; trivially destructible,
+    // so it stays usable while other thread locals are destroyed
+    static bool&
+    exited( )
+    {
+        static thread_local bool e = false;
+        return( e);
+    }
+
+    static Free_lists&
+    lists( )
+    {
+        static thread_local Free_lists l;
+        return( l);
+    }
+
+    static std::size_t
+    class_size( int c)
+    {
+        return( std::size_t( 16) << c);
+    }
+
+    // smallest class holding n bytes, n_classes if there is none
+    static int
+    size_class( std::size_t n)
+    {
+        int c = 0;
+        while ( c < n_classes && class_size( c) < n)
+            ++c;
+        return( c);
+    }
+
+    static void*
+    allocate( std::size_t n)
+    {
+        int c = size_class( n);
+        if ( c == n_classes || exited())
+            return( upstream().allocate( c == n_classes ? n : class_size( c)));
+
+        Free_lists& l = lists();
+        void* p = l.head[ c];
+        if ( !p)
+            return( upstream().allocate( class_size( c)));
+        l.head[ c] = *static_cast< void**>( p);
+        --l.length[ c];
+        return( p);
+    }
+
+    static void
+    deallocate( void* p, std::size_t n)
+    {
+        int c = size_class( n);
+        if ( c == n_classes) {
+            upstream().free( p, n);
+            return;
+        }
+
+        if ( exited() || lists().length[ c] >= max_cached) {
+            upstream().free( p, class_size( c));
+            return;
+        }
+        Free_lists& l = lists();
+        *static_cast< void**>( p) = l.head[ c];
+        l.head[ c] = p;
+        ++l.length[ c];
+    }
+
+    static void*
+    reallocate( void* p, std::size_t old_n, std::size_t new_n)
+    {
+        int old_c = size_class( old_n), new_c = size_class( new_n);
+        if ( old_c == n_classes && new_c == n_classes)
+            return( upstream().reallocate( p, old_n, new_n));
+        if ( old_c == new_c)
+            return( p);
+
+        void* q = allocate( new_n);
+        std::memcpy( q, p, old_n < new_n ? old_n : new_n);
+        deallocate( p, old_n);
+        return( q);
+    }
+};
+
+} //namespace CGAL
+
+#endif // CGAL_MIN_ELLIPSE_2_RUBLEV_GMP_POOL_H
+
+// ===== EOF =================================================================
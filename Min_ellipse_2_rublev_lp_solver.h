@@ -13,7 +13,7 @@
 
 #include "solve_convex_hull_containment_lp.h"
 
-CGAL_BEGIN_NAMESPACE
+namespace CGAL {
 
 // Class declaration
 // =================
@@ -37,9 +37,11 @@ class Min_ellipse_2_rublev_lp_solver {
   private:
     // private data members
     Traits       tco;                           // traits class object
+    Ellipse      current_ellipse;               // current ellipse
     std::list<Point>  points;                   // doubly linked list of points
     int          n_support_points;              // number of support points
     Point*       support_points;                // array of support points
+    Convex_hull_containment_2<Point> support_hull; // hull of support points
     
 
     // copying and assignment not allowed!
@@ -127,7 +129,7 @@ class Min_ellipse_2_rublev_lp_solver {
     const Ellipse&
     ellipse( ) const
     {
-        return( tco.ellipse);
+        return( current_ellipse);
     }
     
     // in-ellipse test predicates
@@ -135,28 +137,28 @@ class Min_ellipse_2_rublev_lp_solver {
     CGAL::Bounded_side
     bounded_side( const Point& p) const
     {
-        return( tco.ellipse.bounded_side( p));
+        return( current_ellipse.bounded_side( p));
     }
     
     inline
     bool
     has_on_bounded_side( const Point& p) const
     {
-        return( tco.ellipse.has_on_bounded_side( p));
+        return( current_ellipse.has_on_bounded_side( p));
     }
     
     inline
     bool
     has_on_boundary( const Point& p) const
     {
-        return( tco.ellipse.has_on_boundary( p));
+        return( current_ellipse.has_on_boundary( p));
     }
     
     inline
     bool
     has_on_unbounded_side( const Point& p) const
     {
-        return( tco.ellipse.has_on_unbounded_side( p));
+        return( current_ellipse.has_on_unbounded_side( p));
     }
 
   private:
@@ -171,7 +173,8 @@ class Min_ellipse_2_rublev_lp_solver {
 		  n_support_points = algo.number_of_support_points();
 		  for (i = 0; i < n_support_points; ++i)
 			  support_points[i] = algo.support_point(i);
-		  tco = algo.traits();
+		  current_ellipse = algo.ellipse();
+		  support_hull.set( support_points + 0, support_points + n_support_points);
 	  } 
 
     void
@@ -185,7 +188,8 @@ class Min_ellipse_2_rublev_lp_solver {
 		bool outlier = true;
 
 		n_support_points = 0;
-		tco.ellipse.set();
+		current_ellipse.set();
+		support_hull.set( support_points + 0, support_points + 0);
 		std::copy( points.begin(), points.end(), std::back_inserter( iter_points[ cur_iter]));
 
 		while ( outlier) {
@@ -195,11 +199,11 @@ class Min_ellipse_2_rublev_lp_solver {
 			for ( typename std::list<Point>::iterator point_iter = iter_points[ cur_iter].begin(); point_iter != last; point_iter++) {
 				const Point& p = *point_iter;
 
-				if ( !is_in_convex_hull( p, support_points + 0, support_points + n_support_points, Point_d(), NT(0)))
+				if ( !support_hull.has_on_closure( p))
 				{
 					iter_points[ 1-cur_iter].push_back( p);
 
-					if ( tco.ellipse.has_on_unbounded_side( p)) {
+					if ( current_ellipse.has_on_unbounded_side( p)) {
 						compute_ellipse( p);
 						outlier = true;
 					}
@@ -248,7 +252,7 @@ class Min_ellipse_2_rublev_lp_solver {
     {
         points.erase( points.begin(), points.end());
         n_support_points = 0;
-        tco.ellipse.set();
+        current_ellipse.set();
     }
     
 
@@ -307,7 +311,7 @@ class Min_ellipse_2_rublev_lp_solver {
 
 //TODO: IO functions needs to be added
 
-CGAL_END_NAMESPACE
+} //namespace CGAL
 
 #endif // CGAL_MIN_ELLIPSE_2_RUBLEV_LP_SOLVER_H
 
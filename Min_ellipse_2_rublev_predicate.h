@@ -0,0 +1,363 @@
+#ifndef CGAL_MIN_ELLIPSE_2_RUBLEV_PREDICATE_H
+#define CGAL_MIN_ELLIPSE_2_RUBLEV_PREDICATE_H
+
+#include <CGAL/Optimisation/basic.h>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace CGAL {
+
+// Cached in-ellipse predicate for four and five support points
+// =============================================================
+// Ellipse::bounded_side() of a 4 point ellipse builds the conic of the
+// pencil through the support points and the query point for every query.
+// This predicate does the support dependent part once per support set:
+//
+// - 5 points: the conic through them, negative inside;
+// - 4 points: two conics B and D spanning the pencil, D without x^2 term
+//   so that every ellipse of the pencil is B + l D, their determinant
+//   polynomials M(l) = det of the quadratic part and N(l) = det of the
+//   whole conic, W = 2 N' M - 3 N M', and an ellipse E0 of the pencil.
+//
+// The conic of the pencil through p is a B + b D with a = D(p) and
+// b = -B(p). If it is an ellipse, i.e. M( a, b) > 0 in homogeneous form,
+// p is outside the smallest ellipse iff sign( a) W( a, b) > 0, as the area
+// N^2 / M^3 decreases towards the smallest ellipse; otherwise p is on the
+// same side of all ellipses of the pencil and E0 decides. A query thus
+// costs two conic evaluations and two binary forms of degree 2 and 4.
+//
+// Before the exact evaluation, side() evaluates the same formulas in
+// double precision with error bounds propagated from the coordinates; it
+// needs no range and decides all but the points very close to the
+// boundary. set() leaves the predicate unset for fewer than four or
+// degenerate support points, and the caller uses the ellipse instead.
+template < class Traits_ >
+class Min_ellipse_2_rublev_predicate;
+
+template < class Traits_ >
+class Min_ellipse_2_rublev_predicate {
+  public:
+    // types
+    typedef typename  Traits_::Point                    Point;
+    typedef typename  Traits_::K::FT                    FT;
+
+  private:
+    // private data members; the conics are r, s, t, u, v, w as in
+    // r x^2 + s y^2 + t xy + u x + v y + w
+    int          n_support_points;              // 4, 5 or 0: unset
+    FT           conic[ 6];                     // 5 points
+    FT           b[ 6], d[ 6], e0[ 6];          // 4 points: B, D, E0,
+    FT           m[ 3], w[ 5];                  // M( l) and W( l)
+    bool         has_filter;                    // the doubles are finite
+    double       conic_d[ 6], b_d[ 6], d_d[ 6], e0_d[ 6], m_d[ 3], w_d[ 5];
+
+    // 2^-48, as in Min_ellipse_2_rublev_filter
+    static double relative_error( ) { return 3.5527136788005009e-15; }
+
+// ============================================================================
+
+// Class implementation
+// ====================
+
+  public:
+    Min_ellipse_2_rublev_predicate( )
+        : n_support_points( 0), has_filter( false)
+    { }
+
+    // prepare the predicate for the ellipse through the given support points
+    void
+    set( const Point* support, int n)
+    {
+        n_support_points = 0;
+        has_filter = false;
+        if ( n == 5 && conic_through_five_points( support, conic)) {
+            n_support_points = 5;
+            has_filter = round( conic, conic_d, 6);
+        } else if ( n == 4 && pencil( support)) {
+            n_support_points = 4;
+            has_filter = round( b, b_d, 6) && round( d, d_d, 6) &&
+                         round( e0, e0_d, 6) && round( m, m_d, 3) &&
+                         round( w, w_d, 5);
+        }
+    }
+
+    bool is_set( ) const { return( n_support_points != 0); }
+
+    // -1: certainly on the bounded side, 1: certainly on the unbounded
+    // side, 0: uncertain
+    int
+    side( double x, double y) const
+    {
+        double value, bound;
+
+        if ( !has_filter)
+            return( 0);
+        if ( n_support_points == 5) {
+            evaluate( conic_d, x, y, value, bound);
+            return( sign_of( value, bound));
+        }
+
+        double a, da, nb, db;
+        evaluate( d_d, x, y, a, da);
+        evaluate( b_d, x, y, nb, db);
+        evaluate( m_d, 2, a, -nb, da, db, value, bound);
+        if ( value > bound) {
+            if ( !( std::fabs( a) > da))
+                return( 0);
+            evaluate( w_d, 4, a, -nb, da, db, value, bound);
+            return( a > 0 ? sign_of( value, bound) : -sign_of( value, bound));
+        }
+        if ( value < -bound) {
+            evaluate( e0_d, x, y, value, bound);
+            return( sign_of( value, bound));
+        }
+        return( 0);
+    }
+
+    // exact side of p, filtered; requires is_set()
+    CGAL::Bounded_side
+    bounded_side( const Point& p) const
+    {
+        CGAL_optimisation_precondition( is_set());
+        switch ( side( CGAL::to_double( p.x()), CGAL::to_double( p.y()))) {
+          case  1: return( CGAL::ON_UNBOUNDED_SIDE);
+          case -1: return( CGAL::ON_BOUNDED_SIDE);
+          default: break;
+        }
+        if ( n_support_points == 5)
+            return( side_of( evaluate( conic, p)));
+
+        FT a = evaluate( d, p), nb = evaluate( b, p);
+        if ( CGAL_NTS sign( ( m[ 0] * a - m[ 1] * nb) * a + m[ 2] * nb * nb) != POSITIVE)
+            return( side_of( evaluate( e0, p)));
+
+        // W( a, b) by Horner in b = -nb
+        FT value = w[ 4], power = a;
+        for ( int k = 3; k >= 0; --k) {
+            value = -value * nb + w[ k] * power;
+            power *= a;
+        }
+        return( side_of( CGAL_NTS sign( a) == POSITIVE ? value : -value));
+    }
+
+    bool
+    has_on_unbounded_side( const Point& p) const
+    {
+        return( bounded_side( p) == CGAL::ON_UNBOUNDED_SIDE);
+    }
+
+    // the conic through five points, as the kernel of the 5x6 system
+    // (x^2, y^2, xy, x, y, 1), oriented with the centroid inside; false if
+    // the points do not determine a conic with the centroid off it
+    static bool
+    conic_through_five_points( const Point* p, FT* exact)
+    {
+        FT mat[ 5][ 6];
+        int pivot_col[ 5];
+        int i, j, col, row = 0, free_col = -1;
+
+        for ( i = 0; i < 5; ++i) {
+            mat[ i][ 0] = p[ i].x() * p[ i].x();
+            mat[ i][ 1] = p[ i].y() * p[ i].y();
+            mat[ i][ 2] = p[ i].x() * p[ i].y();
+            mat[ i][ 3] = p[ i].x();
+            mat[ i][ 4] = p[ i].y();
+            mat[ i][ 5] = FT( 1);
+        }
+        for ( col = 0; col < 6 && row < 5; ++col) {
+            for ( i = row; i < 5 && CGAL_NTS sign( mat[ i][ col]) == ZERO; ++i) ;
+            if ( i == 5) {
+                if ( free_col < 0) free_col = col;
+                continue;
+            }
+            for ( j = 0; j < 6; ++j) std::swap( mat[ row][ j], mat[ i][ j]);
+            for ( i = 0; i < 5; ++i) {
+                if ( i == row || CGAL_NTS sign( mat[ i][ col]) == ZERO) continue;
+                FT f = mat[ i][ col] / mat[ row][ col];
+                for ( j = 0; j < 6; ++j) mat[ i][ j] -= f * mat[ row][ j];
+            }
+            pivot_col[ row++] = col;
+        }
+        if ( row < 5) return( false);
+        if ( free_col < 0) free_col = 5;
+
+        for ( j = 0; j < 6; ++j) exact[ j] = FT( 0);
+        exact[ free_col] = FT( 1);
+        for ( i = 0; i < 5; ++i)
+            exact[ pivot_col[ i]] = -mat[ i][ free_col] / mat[ i][ pivot_col[ i]];
+
+        FT cx( 0), cy( 0);
+        for ( i = 0; i < 5; ++i) {
+            cx += p[ i].x();
+            cy += p[ i].y();
+        }
+        switch ( CGAL_NTS sign( evaluate( exact, Point( cx / FT( 5), cy / FT( 5))))) {
+          case POSITIVE:
+            for ( j = 0; j < 6; ++j) exact[ j] = -exact[ j];
+            break;
+          case ZERO:
+            return( false);
+          default:
+            break;
+        }
+        return( true);
+    }
+
+  private:
+    // Private member functions
+    // ------------------------
+    static FT
+    evaluate( const FT* c, const Point& p)
+    {
+        return( ( c[ 0] * p.x() + c[ 2] * p.y() + c[ 3]) * p.x()
+              + ( c[ 1] * p.y() + c[ 4]) * p.y() + c[ 5]);
+    }
+
+    static CGAL::Bounded_side
+    side_of( const FT& value)
+    {
+        return( CGAL::Bounded_side( -int( CGAL_NTS sign( value))));
+    }
+
+    static int
+    sign_of( double value, double bound)
+    {
+        if ( value >  bound) return(  1);
+        if ( value < -bound) return( -1);
+        return( 0);
+    }
+
+    // conic in double precision and the bound of its error
+    static void
+    evaluate( const double* c, double x, double y, double& value, double& bound)
+    {
+        double ax = std::fabs( x), ay = std::fabs( y);
+        value = ( c[ 0] * x + c[ 2] * y + c[ 3]) * x
+              + ( c[ 1] * y + c[ 4]) * y + c[ 5];
+        bound = ( ( std::fabs( c[ 0]) * ax + std::fabs( c[ 2]) * ay + std::fabs( c[ 3])) * ax
+                + ( std::fabs( c[ 1]) * ay + std::fabs( c[ 4])) * ay + std::fabs( c[ 5]))
+              * relative_error() + (std::numeric_limits<double>::min)();
+    }
+
+    // sum c[ k] a^(n-k) b^k for a and b off by at most da and db; the
+    // propagated error is the growth of the form of the |c[ k]| from |a|,
+    // |b| to |a| + da, |b| + db
+    static void
+    evaluate( const double* c, int n, double a, double b, double da, double db,
+              double& value, double& bound)
+    {
+        double abs_a = std::fabs( a), abs_b = std::fabs( b);
+        double big_a = abs_a + da, big_b = abs_b + db;
+        double power = a, abs_power = abs_a, big_power = big_a;
+        double abs_value = std::fabs( c[ n]), big_value = abs_value;
+        value = c[ n];
+        for ( int k = n - 1; k >= 0; --k) {
+            value = value * b + c[ k] * power;
+            abs_value = abs_value * abs_b + std::fabs( c[ k]) * abs_power;
+            big_value = big_value * big_b + std::fabs( c[ k]) * big_power;
+            power *= a;
+            abs_power *= abs_a;
+            big_power *= big_a;
+        }
+        bound = ( big_value - abs_value) + 2 * relative_error() * big_value
+              + (std::numeric_limits<double>::min)();
+    }
+
+    static bool
+    round( const FT* exact, double* c, int n)
+    {
+        for ( int i = 0; i < n; ++i) {
+            c[ i] = CGAL::to_double( exact[ i]);
+            if ( !( std::fabs( c[ i]) <= (std::numeric_limits<double>::max)()))
+                return( false);
+        }
+        return( true);
+    }
+
+    // the pair of lines through p, q and through r, s
+    static void
+    line_pair( const Point& p, const Point& q, const Point& r, const Point& s,
+               FT* c)
+    {
+        FT a1 = p.y() - q.y(), b1 = q.x() - p.x(), c1 = p.x() * q.y() - p.y() * q.x();
+        FT a2 = r.y() - s.y(), b2 = s.x() - r.x(), c2 = r.x() * s.y() - r.y() * s.x();
+        c[ 0] = a1 * a2;
+        c[ 1] = b1 * b2;
+        c[ 2] = a1 * b2 + a2 * b1;
+        c[ 3] = a1 * c2 + a2 * c1;
+        c[ 4] = b1 * c2 + b2 * c1;
+        c[ 5] = c1 * c2;
+    }
+
+    // determinant of the symmetric matrix 2 [ r t/2 u/2; t/2 s v/2; u/2 v/2 w]
+    // of c + l e
+    static FT
+    det3( const FT* c, const FT& l, const FT* e)
+    {
+        FT r = FT( 2) * ( c[ 0] + l * e[ 0]), s = FT( 2) * ( c[ 1] + l * e[ 1]);
+        FT t = c[ 2] + l * e[ 2], u = c[ 3] + l * e[ 3], v = c[ 4] + l * e[ 4];
+        FT ww = FT( 2) * ( c[ 5] + l * e[ 5]);
+        return( r * ( s * ww - v * v) - t * ( t * ww - v * u) + u * ( t * v - s * u));
+    }
+
+    // the pencil data of four points in convex position
+    bool
+    pencil( const Point* p)
+    {
+        FT c1[ 6], c2[ 6], n[ 4];
+        int i, j;
+
+        line_pair( p[ 0], p[ 1], p[ 2], p[ 3], c1);
+        line_pair( p[ 0], p[ 2], p[ 1], p[ 3], c2);
+        const FT* base = CGAL_NTS sign( c1[ 0]) != ZERO ? c1 : c2;
+        if ( CGAL_NTS sign( base[ 0]) == ZERO)
+            return( false);
+        FT orient = CGAL_NTS sign( base[ 0]) == POSITIVE ? FT( 1) : FT( -1);
+        for ( i = 0; i < 6; ++i) {
+            b[ i] = orient * base[ i];
+            d[ i] = c1[ 0] * c2[ i] - c2[ 0] * c1[ i];
+        }
+
+        // M( l) = 4 r s - t^2 of B + l D, where D has r = 0
+        m[ 0] = FT( 4) * b[ 0] * b[ 1] - b[ 2] * b[ 2];
+        m[ 1] = FT( 4) * b[ 0] * d[ 1] - FT( 2) * b[ 2] * d[ 2];
+        m[ 2] = -d[ 2] * d[ 2];
+
+        // N( l) from its values at 0, 1, -1 and its leading coefficient
+        const FT zero( 0), one( 1), minus_one( -1);
+        n[ 0] = det3( b, zero, d);
+        n[ 3] = det3( d, zero, b);
+        FT odd  = det3( b, one, d) - n[ 0] - n[ 3];
+        FT even = det3( b, minus_one, d) - n[ 0] + n[ 3];
+        n[ 1] = ( odd - even) / FT( 2);
+        n[ 2] = ( odd + even) / FT( 2);
+
+        // W = 2 N' M - 3 N M'
+        FT dn[ 3] = { n[ 1], FT( 2) * n[ 2], FT( 3) * n[ 3] };
+        FT dm[ 2] = { m[ 1], FT( 2) * m[ 2] };
+        for ( i = 0; i < 5; ++i) w[ i] = FT( 0);
+        for ( i = 0; i < 3; ++i)
+            for ( j = 0; j < 3; ++j) w[ i+j] += FT( 2) * dn[ i] * m[ j];
+        for ( i = 0; i < 4; ++i)
+            for ( j = 0; j < 2; ++j) w[ i+j] -= FT( 3) * n[ i] * dm[ j];
+
+        // E0 = B + l D at the maximum of M, or where M = 1 if M is linear
+        FT l( 0);
+        if ( CGAL_NTS sign( m[ 2]) != ZERO)
+            l = -m[ 1] / ( FT( 2) * m[ 2]);
+        else if ( CGAL_NTS sign( m[ 1]) != ZERO)
+            l = ( FT( 1) - m[ 0]) / m[ 1];
+        if ( CGAL_NTS sign( ( m[ 2] * l + m[ 1]) * l + m[ 0]) != POSITIVE)
+            return( false);
+        for ( i = 0; i < 6; ++i)
+            e0[ i] = b[ i] + l * d[ i];
+        return( true);
+    }
+};
+
+} //namespace CGAL
+
+#endif // CGAL_MIN_ELLIPSE_2_RUBLEV_PREDICATE_H
+
+// ===== EOF =================================================================
@@ -0,0 +1,240 @@
+#ifndef CGAL_MIN_ELLIPSE_2_RUBLEV_QUERY_H
+#define CGAL_MIN_ELLIPSE_2_RUBLEV_QUERY_H
+
+#include <CGAL/Optimisation/basic.h>
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+#include "Min_ellipse_2_rublev.h"
+#include "Min_ellipse_2_rublev_filter.h"
+
+namespace CGAL {
+
+// Bulk containment queries against a computed ellipse
+// ===================================================
+// Holds the ellipse of a solved Min_ellipse_2_rublev together with the
+// double conic of its floating-point filter. Arrays of query points are
+// classified in blocks: the filter (AVX-512 or AVX2/FMA when compiled for
+// it) decides almost all points, and only points too close to the
+// boundary for its error bound are tested exactly. The filter range is
+// fitted to every block, so the queries need not lie near the solved
+// points. The 4 point ellipse has no filter conic; its queries, like the
+// exact tests of the 5 point ellipse, go through the cached
+// Min_ellipse_2_rublev_predicate and its own filter.
+//
+// The results are written as a bitmask, bit i % 64 of word i / 64 being
+// set for the points on the unbounded side. The blocks are distributed
+// over n_threads threads (0: as many as OpenMP offers).
+template < class Traits_ >
+class Min_ellipse_2_rublev_query;
+
+template < class Traits_ >
+class Min_ellipse_2_rublev_query {
+  public:
+    // types
+    typedef           Traits_                           Traits;
+    typedef typename  Traits_::Point                    Point;
+    typedef typename  Traits_::Ellipse                  Ellipse;
+    typedef           Min_ellipse_2_rublev< Traits_ >   Solver;
+    typedef           std::uint64_t                     Word;
+
+  private:
+    // private data members
+    Ellipse      current_ellipse;
+    Min_ellipse_2_rublev_filter< Traits_ > filter;
+    Min_ellipse_2_rublev_predicate< Traits_ > predicate;
+    int          n_threads;
+
+    // points are classified in blocks of this size, a multiple of the bits
+    // of a Word, so that the threads write disjoint words
+    enum { block_size = 256 };
+
+// ============================================================================
+
+// Class implementation
+// ====================
+
+  public:
+    // Constructor
+    // -----------
+    explicit
+    Min_ellipse_2_rublev_query( const Solver& me, int threads = 0)
+        : current_ellipse( me.ellipse()), n_threads( threads)
+    {
+        Point support[ 5];
+        std::copy( me.support_points_begin(), me.support_points_end(), support);
+        filter.set( support, me.number_of_support_points());
+        predicate.set( support, me.number_of_support_points());
+    }
+
+    // Access functions
+    // ----------------
+    inline
+    const Ellipse&
+    ellipse( ) const
+    {
+        return( current_ellipse);
+    }
+
+    // number of words of a bitmask for n points
+    static
+    std::size_t
+    number_of_words( std::size_t n)
+    {
+        return( ( n + 63) / 64);
+    }
+
+    // Predicates
+    // ----------
+    bool
+    has_on_unbounded_side( const Point& p) const
+    {
+        double x = CGAL::to_double( p.x()), y = CGAL::to_double( p.y());
+        Min_ellipse_2_rublev_filter< Traits_ > local( filter);
+        local.set_range( std::fabs( x), std::fabs( y));
+        int side = local.side( x, y);
+        if ( side != 0)
+            return( side > 0);
+        return( is_outside( p));
+    }
+
+    // classify the points ( x[ i], y[ i]), i in [0, n), into the
+    // number_of_words( n) words of bits; returns the number of points on the
+    // unbounded side
+    std::size_t
+    has_on_unbounded_side( const double* x, const double* y, std::size_t n,
+                           Word* bits) const
+    {
+        const long n_blocks = long( ( n + block_size - 1) / block_size);
+        std::size_t n_outside = 0;
+        long block;
+
+#ifdef _OPENMP
+#pragma omp parallel for schedule( static) num_threads( number_of_threads()) \
+        reduction( +: n_outside) if ( n_blocks > 1)
+#endif
+        for ( block = 0; block < n_blocks; ++block)
+        {
+            std::size_t first = std::size_t( block) * block_size;
+            std::size_t m = (std::min)( std::size_t( block_size), n - first);
+            Double_points exact = { x + first, y + first };
+            n_outside += classify( x + first, y + first, m, exact, bits + first / 64);
+        }
+        return( n_outside);
+    }
+
+    // the same for a random access range of points
+    template < class RandomAccessIterator >
+    std::size_t
+    has_on_unbounded_side( RandomAccessIterator first, RandomAccessIterator last,
+                           Word* bits) const
+    {
+        const std::size_t n = last - first;
+        const long n_blocks = long( ( n + block_size - 1) / block_size);
+        std::size_t n_outside = 0;
+        long block;
+
+#ifdef _OPENMP
+#pragma omp parallel for schedule( static) num_threads( number_of_threads()) \
+        reduction( +: n_outside) if ( n_blocks > 1)
+#endif
+        for ( block = 0; block < n_blocks; ++block)
+        {
+            double x[ block_size], y[ block_size];
+            std::size_t base = std::size_t( block) * block_size;
+            std::size_t m = (std::min)( std::size_t( block_size), n - base), k;
+            for ( k = 0; k < m; ++k)
+            {
+                x[ k] = CGAL::to_double( first[ base + k].x());
+                y[ k] = CGAL::to_double( first[ base + k].y());
+            }
+            Range_points< RandomAccessIterator> exact = { first + base };
+            n_outside += classify( x, y, m, exact, bits + base / 64);
+        }
+        return( n_outside);
+    }
+
+  private:
+    // Private member functions
+    // ------------------------
+    inline int
+    number_of_threads( ) const
+    {
+#ifdef _OPENMP
+        return( n_threads > 0 ? n_threads : omp_get_max_threads());
+#else
+        return( 1);
+#endif
+    }
+
+    // the exact points of a block, for the points the filter cannot
+    // decide: the caller's points, or points built from coordinates which
+    // are exact as doubles
+    template < class RandomAccessIterator >
+    struct Range_points {
+        RandomAccessIterator first;
+        Point operator()( std::size_t j) const { return( first[ j]); }
+    };
+
+    struct Double_points {
+        const double *x, *y;
+        Point operator()( std::size_t j) const { return( Point( x[ j], y[ j])); }
+    };
+
+    // exact test of a point the filter could not decide
+    bool
+    is_outside( const Point& p) const
+    {
+        if ( predicate.is_set())
+            return( predicate.has_on_unbounded_side( p));
+        return( current_ellipse.has_on_unbounded_side( p));
+    }
+
+    // one block of m <= block_size points, written to m / 64 rounded up
+    // words; x and y are the coordinates rounded to double, exact( j) is
+    // point j itself
+    template < class Exact_points >
+    std::size_t
+    classify( const double* x, const double* y, std::size_t m,
+              const Exact_points& exact, Word* bits) const
+    {
+        signed char sides[ block_size];
+        double max_x = 0, max_y = 0;
+        std::size_t k, n_outside = 0;
+
+        for ( k = 0; k < m; ++k)
+        {
+            max_x = (std::max)( max_x, std::fabs( x[ k]));
+            max_y = (std::max)( max_y, std::fabs( y[ k]));
+        }
+        Min_ellipse_2_rublev_filter< Traits_ > local( filter);
+        local.set_range( max_x, max_y);
+        local.side( x, y, m, sides);
+
+        for ( k = 0; k < m; k += 64)
+        {
+            std::size_t j, end = (std::min)( k + 64, m);
+            Word word = 0;
+            for ( j = k; j < end; ++j)
+            {
+                bool outside = sides[ j] > 0 ||
+                    ( sides[ j] == 0 && is_outside( exact( j)));
+                word |= Word( outside) << ( j - k);
+                n_outside += outside;
+            }
+            bits[ k / 64] = word;
+        }
+        return( n_outside);
+    }
+};
+
+} //namespace CGAL
+
+#endif // CGAL_MIN_ELLIPSE_2_RUBLEV_QUERY_H
+
+// ===== EOF =================================================================
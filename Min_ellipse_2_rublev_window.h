@@ -0,0 +1,464 @@
+#ifndef CGAL_MIN_ELLIPSE_2_RUBLEV_WINDOW_H
+#define CGAL_MIN_ELLIPSE_2_RUBLEV_WINDOW_H
+
+#include <CGAL/Optimisation/basic.h>
+#include <vector>
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+
+#include "Min_ellipse_2_rublev.h"
+#include "Min_ellipse_2_rublev_filter.h"
+
+namespace CGAL {
+
+// Min ellipse of a sliding window
+// ===============================
+// The points arrive at the back of the window with push_back() and expire
+// at its front with pop_front(), in arrival order; a time based window
+// pops while its oldest point is too old.
+//
+// Only the candidates are stored: the window's points minus those known
+// to be dominated for the rest of their lifetime. After every solve the
+// candidates which are older than all support points and certainly inside
+// the convex hull of the support points are dropped. The support points
+// outlive them, so these points stay inside the ellipse of every later
+// window until they expire.
+//
+// A point which arrives inside the ellipse is only appended to the
+// candidates, and a point which is not a support point expires without
+// further work. The ellipse changes only if an arriving point is outside or
+// an expiring point is a support point. In the second case it is recomputed
+// from all candidates, in place through a view of Min_ellipse_2_rublev.
+//
+// An arriving point outside the ellipse only needs the outer candidates:
+// those not certainly inside the convex hull of the support points, which
+// include the support points. The candidates inside are inside the hull of
+// the outer ones, hence inside the ellipse of the outer ones and the new
+// point, so that ellipse is solved, warm started from the old support
+// points and the new one, and the outer candidates are filtered against
+// the new support hull. A candidate left out this way depends on the
+// support points of the filter; once the oldest of these expires, the
+// outer candidates are rebuilt from all candidates before the next such
+// solve, by the double filter only.
+template < class Traits_ >
+class Min_ellipse_2_rublev_window;
+
+template < class Traits_ >
+class Min_ellipse_2_rublev_window {
+  public:
+    // types
+    typedef           Traits_                           Traits;
+    typedef typename  Traits_::Point                    Point;
+    typedef typename  Traits_::Ellipse                  Ellipse;
+    typedef           Min_ellipse_2_rublev< Traits_ >   Solver;
+    typedef typename  Solver::Options                   Options;
+    typedef typename  Solver::Support_point_iterator    Support_point_iterator;
+
+  private:
+    // private data members
+    Solver       solver;                        // view of the candidates
+    std::vector< Point>        points;          // candidates, oldest first,
+    std::vector< std::size_t>  ids;             // and their arrival numbers,
+    std::size_t  head;                          // from position head on
+    std::size_t  first_id, next_id;             // window: [first_id, next_id)
+    std::size_t  support_ids[ 5];               // arrival numbers
+    int          n_support_points;
+    std::vector< Point>        outer_points;    // outer candidates, oldest
+    std::vector< std::size_t>  outer_ids;       // first, from position
+    std::size_t  outer_head;                    // outer_head on
+    std::size_t  exposed_id;                    // its expiry makes them stale
+    bool         outer_stale;
+    double       max_x, max_y;                  // range of all candidates
+    Min_ellipse_2_rublev_hull_filter< Traits_ > hull_filter;
+    std::size_t  n_solves;
+    std::size_t  n_dropped_points;
+
+    // copying and assignment not allowed!
+    Min_ellipse_2_rublev_window( const Min_ellipse_2_rublev_window<Traits_>&);
+    Min_ellipse_2_rublev_window<Traits_>& operator = ( const Min_ellipse_2_rublev_window<Traits_>&);
+
+// ============================================================================
+
+// Class implementation
+// ====================
+
+  public:
+    // Constructor
+    // -----------
+    // The solver options apply to every solve, except that the candidates
+    // are solved sequentially, in arrival order and without streaming,
+    // hull first or divide and conquer mode, so that the support points can
+    // be told by position.
+    explicit
+    Min_ellipse_2_rublev_window( const Options& solver_options = Options(),
+                                 const Traits& traits = Traits())
+        : solver( window_options( solver_options), traits),
+          head( 0), first_id( 0), next_id( 0), n_support_points( 0),
+          outer_head( 0), exposed_id( no_id()), outer_stale( false),
+          max_x( 0), max_y( 0), n_solves( 0), n_dropped_points( 0)
+    { }
+
+    // Access functions
+    // ----------------
+    // #points in the window and #candidates stored
+    inline
+    std::size_t
+    number_of_points( ) const
+    {
+        return( next_id - first_id);
+    }
+
+    inline
+    std::size_t
+    number_of_candidates( ) const
+    {
+        return( points.size() - head);
+    }
+
+    // #outer candidates, which an outside point is solved with
+    inline
+    std::size_t
+    number_of_outer_candidates( ) const
+    {
+        return( outer_points.size() - outer_head);
+    }
+
+    // number of solves and of points dropped as dominated since
+    // construction or clear()
+    inline
+    std::size_t
+    number_of_solves( ) const
+    {
+        return( n_solves);
+    }
+
+    inline
+    std::size_t
+    number_of_dropped_points( ) const
+    {
+        return( n_dropped_points);
+    }
+
+    inline
+    int
+    number_of_support_points( ) const
+    {
+        return( n_support_points);
+    }
+
+    inline
+    bool
+    is_empty( ) const
+    {
+        return( number_of_points() == 0);
+    }
+
+    inline
+    Support_point_iterator
+    support_points_begin( ) const
+    {
+        return( solver.support_points_begin());
+    }
+
+    inline
+    Support_point_iterator
+    support_points_end( ) const
+    {
+        return( solver.support_points_end());
+    }
+
+    inline
+    const Point&
+    support_point( int i) const
+    {
+        return( solver.support_point( i));
+    }
+
+    // arrival number of support point i; the first point pushed after
+    // construction or clear() is number 0
+    inline
+    std::size_t
+    support_point_id( int i) const
+    {
+        CGAL_optimisation_precondition( ( i >= 0) &&
+                                        ( i < number_of_support_points()));
+        return( support_ids[ i]);
+    }
+
+    inline
+    const Ellipse&
+    ellipse( ) const
+    {
+        return( solver.ellipse());
+    }
+
+    // in-ellipse test predicate
+    inline
+    bool
+    has_on_unbounded_side( const Point& p) const
+    {
+        return( !is_empty() && solver.has_on_unbounded_side( p));
+    }
+
+    // Modifiers
+    // ---------
+    // append p to the window; returns its arrival number
+    std::size_t
+    push_back( const Point& p)
+    {
+        // a point in the support hull is inside the ellipse
+        bool in_hull = !is_empty() &&
+            hull_filter.has_on_bounded_side( CGAL::to_double( p.x()),
+                                             CGAL::to_double( p.y()));
+        bool outside = is_empty() ||
+            ( !in_hull && solver.has_on_unbounded_side( p));
+
+        points.push_back( p);
+        ids.push_back( next_id);
+        max_x = (std::max)( max_x, std::fabs( CGAL::to_double( p.x())));
+        max_y = (std::max)( max_y, std::fabs( CGAL::to_double( p.y())));
+
+        if ( outside && outer_stale)
+            rebuild_outer();                    // includes p
+        else if ( !in_hull) {
+            outer_points.push_back( p);
+            outer_ids.push_back( next_id);
+        }
+        if ( outside)
+            solve_outer();
+        return( next_id++);
+    }
+
+    // remove the oldest point from the window
+    void
+    pop_front( )
+    {
+        CGAL_optimisation_precondition( !is_empty());
+        std::size_t id = first_id++;
+
+        if ( id == exposed_id) {
+            outer_stale = true;
+            exposed_id = no_id();
+        }
+        if ( outer_head < outer_ids.size() && outer_ids[ outer_head] == id) {
+            ++outer_head;
+            if ( 2 * outer_head >= outer_ids.size())
+                compact_outer();
+        }
+
+        // a dropped point expires unnoticed
+        if ( head == points.size() || ids[ head] != id)
+            return;
+        ++head;
+        if ( 2 * head >= points.size())
+            compact();
+
+        for ( int i = 0; i < n_support_points; ++i)
+            if ( support_ids[ i] == id)
+            {
+                solve();
+                return;
+            }
+    }
+
+    void
+    clear( )
+    {
+        points.clear();
+        ids.clear();
+        head = 0;
+        first_id = next_id = 0;
+        n_support_points = 0;
+        outer_points.clear();
+        outer_ids.clear();
+        outer_head = 0;
+        exposed_id = no_id();
+        outer_stale = false;
+        max_x = max_y = 0;
+        hull_filter.set( 0, 0);
+        n_solves = 0;
+        n_dropped_points = 0;
+        solver.clear();
+    }
+
+  private:
+    // Private member functions
+    // ------------------------
+    static std::size_t no_id( ) { return( std::size_t( -1)); }
+
+    static Options
+    window_options( Options options)
+    {
+        options.parallel = false;
+        options.streaming = false;
+        options.hull_first = false;
+        options.random_permutation = false;
+        options.divide_and_conquer = false;
+        if ( options.update_strategy == Solver::MOVE_TO_FRONT_UPDATES)
+            options.update_strategy = Solver::RESTART_UPDATES;
+        return( options);
+    }
+
+    // move the candidates to the front of the arrays
+    void
+    compact( )
+    {
+        points.erase( points.begin(), points.begin() + head);
+        ids.erase( ids.begin(), ids.begin() + head);
+        head = 0;
+    }
+
+    void
+    compact_outer( )
+    {
+        outer_points.erase( outer_points.begin(), outer_points.begin() + outer_head);
+        outer_ids.erase( outer_ids.begin(), outer_ids.begin() + outer_head);
+        outer_head = 0;
+    }
+
+    // solve the candidates in place, warm started from the support points
+    // and the point p (if any), and drop the dominated ones
+    void
+    solve( const std::vector< Point>& candidates,
+           const std::vector< std::size_t>& candidate_ids,
+           std::size_t first_candidate, const Point* p = 0)
+    {
+        ++n_solves;
+        Point hints[ 6];
+        int i, n_hints = n_support_points;
+        for ( i = 0; i < n_support_points; ++i)
+            hints[ i] = solver.support_point( i);
+        if ( p != 0)
+            hints[ n_hints++] = *p;
+        const Point* first = candidates.empty() ? 0 : &candidates[ 0];
+        solver.resolve_view( first + first_candidate, first + candidates.size(),
+                             hints, hints + n_hints);
+
+        n_support_points = solver.number_of_support_points();
+        for ( i = 0; i < n_support_points; ++i)
+            support_ids[ i] = candidate_ids[ first_candidate +
+                                            solver.support_point_index( i)];
+        drop_dominated_points();
+    }
+
+    // recompute the ellipse from all candidates
+    void
+    solve( )
+    {
+        solve( points, ids, head);
+        rebuild_outer();
+    }
+
+    // recompute the ellipse after the outside point, the last outer
+    // candidate, arrived
+    void
+    solve_outer( )
+    {
+        Point p = outer_points.back();
+        solve( outer_points, outer_ids, outer_head, &p);
+        filter_outer( outer_points, outer_ids, outer_head);
+    }
+
+    void
+    rebuild_outer( )
+    {
+        exposed_id = no_id();
+        outer_stale = false;
+        filter_outer( points, ids, head);
+    }
+
+    // the candidates [ first, end) of the given arrays which are not
+    // certainly inside the support hull become the outer candidates; the
+    // arrays may be the outer candidates themselves
+    void
+    filter_outer( const std::vector< Point>& candidates,
+                  const std::vector< std::size_t>& candidate_ids,
+                  std::size_t first)
+    {
+        const std::size_t n = candidates.size();
+        std::size_t i, k = 0;
+        if ( &candidates != &outer_points) {
+            outer_points.resize( n - first);
+            outer_ids.resize( n - first);
+        }
+        for ( i = first; i < n; ++i) {
+            const Point& q = candidates[ i];
+            if ( hull_filter.has_on_bounded_side( CGAL::to_double( q.x()),
+                                                  CGAL::to_double( q.y())))
+                continue;
+            if ( k != i || &candidates != &outer_points) {
+                outer_points[ k] = q;
+                outer_ids[ k] = candidate_ids[ i];
+            }
+            ++k;
+        }
+        outer_points.resize( k);
+        outer_ids.resize( k);
+        outer_head = 0;
+
+        for ( int j = 0; j < n_support_points; ++j)
+            exposed_id = (std::min)( exposed_id, support_ids[ j]);
+    }
+
+    // drop the candidates older than all support points which are
+    // certainly inside the convex hull of the support points
+    void
+    drop_dominated_points( )
+    {
+        if ( n_support_points < 3)
+        {
+            hull_filter.set( 0, 0);
+            return;
+        }
+
+        // the support points are on the ellipse, i.e. in convex position;
+        // sort them counterclockwise around the first one
+        typename Point::R::Orientation_2 orientation =
+            typename Point::R().orientation_2_object();
+        Point hull[ 5];
+        std::size_t oldest = support_ids[ 0];
+        int i, j;
+        for ( i = 0; i < n_support_points; ++i)
+        {
+            hull[ i] = solver.support_point( i);
+            oldest = (std::min)( oldest, support_ids[ i]);
+        }
+        for ( i = 2; i < n_support_points; ++i)
+            for ( j = i; j > 1 && orientation( hull[ 0], hull[ j],
+                                               hull[ j-1]) == COUNTERCLOCKWISE; --j)
+                std::swap( hull[ j], hull[ j-1]);
+        hull_filter.set_range( max_x, max_y);
+        hull_filter.set( hull, n_support_points);
+
+        // compact the candidates older than the oldest support point
+        // towards it, preserving their order
+        std::size_t end = head, k;
+        while ( end < ids.size() && ids[ end] < oldest)
+            ++end;
+        for ( k = end; k > head; )
+        {
+            --k;
+            const Point& p = points[ k];
+            if ( hull_filter.has_on_bounded_side( CGAL::to_double( p.x()),
+                                                  CGAL::to_double( p.y())))
+                continue;
+            --end;
+            if ( end != k)
+            {
+                points[ end] = points[ k];
+                ids[ end] = ids[ k];
+            }
+        }
+        n_dropped_points += end - head;
+        head = end;
+        if ( 2 * head >= points.size())
+            compact();
+    }
+};
+
+} //namespace CGAL
+
+#endif // CGAL_MIN_ELLIPSE_2_RUBLEV_WINDOW_H
+
+// ===== EOF =================================================================
@@ -0,0 +1,726 @@
+#ifndef CGAL_MIN_ELLIPSOID_3_RUBLEV_H
+#define CGAL_MIN_ELLIPSOID_3_RUBLEV_H
+
+#include <CGAL/Optimisation/basic.h>
+#include <vector>
+#include <algorithm>
+#include <iterator>
+#include <cmath>
+#include <limits>
+#include <cstddef>
+
+namespace CGAL {
+
+// Min ellipsoid in 3D with the domination heuristic
+// =================================================
+// The passes of Min_ellipse_2_rublev carried over to three dimensions: a
+// point outside the current ellipsoid extends the working set and the
+// ellipsoid is recomputed from it, a point strictly inside the convex hull
+// of the support points (up to 9 in 3D) is dropped for good.
+//
+// The smallest ellipsoid of a working set has no rational construction
+// in 3D, so it is computed in double precision like in
+// Min_ellipse_2_khachiyan: Khachiyan's dual weights on the working set,
+// optimized by Todd and Yildirim's iteration with away steps. For weights
+// u with center c and scatter matrix S, the ellipsoid
+// (x-c)^T S^-1 (x-c) <= 3 has at most the volume of the minimum
+// ellipsoid; a point is outside if it exceeds 3 (1+eps)^2. ellipsoid() is
+// the ellipsoid at that bound: it contains every point, and shrunk by the
+// factor 1+eps about its center it is no larger than the minimum
+// ellipsoid. Containment is decided for the double approximations of the
+// points, with a relative margin of 1e-12 against rounding.
+//
+// The support points are the (at most 9) heaviest points of the working
+// set. Their convex hull is enumerated by brute force with orientation
+// tests under a static error bound; if one of the tests is uncertain,
+// nothing is dropped until the support set changes, so every dropped
+// point is certainly in the hull of points of the working set and thus in
+// the final ellipsoid.
+//
+// Without the heuristic, every pass tests all points and moves every
+// point outside the ellipsoid to the front, as in Welzl's algorithm; this
+// is the baseline the heuristic is measured against.
+template < class Kernel_ >
+class Min_ellipsoid_3_rublev;
+
+template < class Kernel_ >
+class Min_ellipsoid_3_rublev {
+  public:
+    // types
+    typedef           Kernel_                           Kernel;
+    typedef typename  Kernel_::Point_3                  Point;
+    typedef typename  std::vector<Point>::const_iterator  Point_iterator;
+
+    enum { max_support_points = 9 };
+
+    // solver options; the tolerance eps is relative to the linear size
+    struct Options {
+        bool        use_convex_hull_heuristic;
+        double      epsilon;
+
+        Options( )
+            : use_convex_hull_heuristic( true),
+              epsilon( 1e-4)
+        { }
+    };
+
+    // the ellipsoid (x - center)^T M (x - center) <= 1 with the symmetric
+    // matrix M = [ m11 m12 m13; m12 m22 m23; m13 m23 m33]; degenerate if
+    // the points are coplanar, which leaves it without interior
+    class Ellipsoid {
+      public:
+        Ellipsoid( )
+            : degenerate( true)
+        {
+            for ( int i = 0; i < 3; ++i) center[ i] = 0;
+            for ( int i = 0; i < 6; ++i) m[ i] = 0;
+        }
+
+        bool   is_degenerate( )  const { return( degenerate); }
+        double center_x( )       const { return( center[ 0]); }
+        double center_y( )       const { return( center[ 1]); }
+        double center_z( )       const { return( center[ 2]); }
+
+        // M in the order m11, m12, m13, m22, m23, m33
+        const double* matrix( )  const { return( m); }
+
+        double
+        volume( ) const
+        {
+            if ( degenerate)
+                return( 0);
+            double det = m[ 0] * ( m[ 3] * m[ 5] - m[ 4] * m[ 4])
+                       - m[ 1] * ( m[ 1] * m[ 5] - m[ 4] * m[ 2])
+                       + m[ 2] * ( m[ 1] * m[ 4] - m[ 3] * m[ 2]);
+            return( 4.18879020478639098461 / std::sqrt( det));
+        }
+
+        Bounded_side
+        bounded_side( double x, double y, double z) const
+        {
+            if ( degenerate)
+                return( ON_UNBOUNDED_SIDE);
+            double dx = x - center[ 0], dy = y - center[ 1], dz = z - center[ 2];
+            double r = m[ 0] * dx * dx + m[ 3] * dy * dy + m[ 5] * dz * dz
+                     + 2 * ( m[ 1] * dx * dy + m[ 2] * dx * dz + m[ 4] * dy * dz);
+            return( r < 1 ? ON_BOUNDED_SIDE
+                          : ( r == 1 ? ON_BOUNDARY : ON_UNBOUNDED_SIDE));
+        }
+
+        Bounded_side
+        bounded_side( const Point& p) const
+        {
+            return( bounded_side( CGAL::to_double( p.x()),
+                                  CGAL::to_double( p.y()),
+                                  CGAL::to_double( p.z())));
+        }
+
+        bool
+        has_on_bounded_side( const Point& p) const
+        {
+            return( bounded_side( p) == ON_BOUNDED_SIDE);
+        }
+
+        bool
+        has_on_unbounded_side( const Point& p) const
+        {
+            return( bounded_side( p) == ON_UNBOUNDED_SIDE);
+        }
+
+      private:
+        friend class Min_ellipsoid_3_rublev< Kernel_ >;
+
+        double center[ 3];
+        double m[ 6];
+        bool   degenerate;
+    };
+
+  private:
+    // private data members
+    Options      options;
+    std::vector<Point>  points;                 // contiguous array of points
+    std::vector< double> point_x, point_y, point_z;
+    Ellipsoid    current_ellipsoid;
+
+    // working set: indices into points and their weights
+    std::vector< std::size_t> working;
+    std::vector< double> weight;
+
+    // center and inverse scatter matrix (m11, m12, m13, m22, m23, m33) of
+    // the current weights
+    double       center[ 3];
+    double       s_inv[ 6];
+
+    // support points: indices into points, and the facets of their hull
+    // as triples of support point numbers with the side of the interior
+    int          n_support_points;
+    std::size_t  support_ids[ max_support_points];
+    double       support_xyz[ max_support_points][ 3];
+    enum { max_facets = 2 * max_support_points - 4 };
+    int          n_facets;                      // 0: no hull to test
+    int          facets[ max_facets][ 3];
+    int          facet_side[ max_facets];
+
+    // survivors of the previous pass, for the heuristic
+    std::vector< std::size_t> survivors;
+    bool         coplanar;                      // no ellipsoid exists
+
+    std::size_t  n_passes;                      // sweeps over the points
+    std::size_t  n_updates;                     // working set extensions
+    std::size_t  n_iterations;                  // weight updates
+
+    enum { max_iterations = 100000 };
+
+    // copying and assignment not allowed!
+    Min_ellipsoid_3_rublev( const Min_ellipsoid_3_rublev<Kernel_>&);
+    Min_ellipsoid_3_rublev<Kernel_>& operator = ( const Min_ellipsoid_3_rublev<Kernel_>&);
+
+// ============================================================================
+
+// Class implementation
+// ====================
+
+  public:
+    // Access functions and predicates
+    // -------------------------------
+    inline
+    std::size_t
+    number_of_points( ) const
+    {
+        return( points.size());
+    }
+
+    inline
+    int
+    number_of_support_points( ) const
+    {
+        return( n_support_points);
+    }
+
+    inline
+    Point_iterator
+    points_begin( ) const
+    {
+        return( points.begin());
+    }
+
+    inline
+    Point_iterator
+    points_end( ) const
+    {
+        return( points.end());
+    }
+
+    inline
+    const Point&
+    support_point( int i) const
+    {
+        CGAL_optimisation_precondition( (i >= 0) &&
+                                        (i <  number_of_support_points()));
+        return( points[ support_ids[ i]]);
+    }
+
+    // index into points of support point i; without the heuristic points
+    // are moved to the front, so this need not be the input position
+    inline
+    std::size_t
+    support_point_index( int i) const
+    {
+        CGAL_optimisation_precondition( (i >= 0) &&
+                                        (i <  number_of_support_points()));
+        return( support_ids[ i]);
+    }
+
+    inline
+    const Ellipsoid&
+    ellipsoid( ) const
+    {
+        return( current_ellipsoid);
+    }
+
+    // number of sweeps over the points, of working set extensions and of
+    // weight updates
+    inline
+    std::size_t
+    number_of_passes( ) const
+    {
+        return( n_passes);
+    }
+
+    inline
+    std::size_t
+    number_of_updates( ) const
+    {
+        return( n_updates);
+    }
+
+    inline
+    std::size_t
+    number_of_iterations( ) const
+    {
+        return( n_iterations);
+    }
+
+    inline
+    bool
+    has_on_unbounded_side( const Point& p) const
+    {
+        return( current_ellipsoid.has_on_unbounded_side( p));
+    }
+
+  private:
+    // Private member functions
+    // ------------------------
+    // sign of the orientation of (a, b, c, d) under a static error bound
+    // (Shewchuk's o3derrboundA), 0 if uncertain
+    static int
+    orientation( const double* a, const double* b, const double* c,
+                 const double* d)
+    {
+        double adx = a[ 0] - d[ 0], ady = a[ 1] - d[ 1], adz = a[ 2] - d[ 2];
+        double bdx = b[ 0] - d[ 0], bdy = b[ 1] - d[ 1], bdz = b[ 2] - d[ 2];
+        double cdx = c[ 0] - d[ 0], cdy = c[ 1] - d[ 1], cdz = c[ 2] - d[ 2];
+        double bdxcdy = bdx * cdy, cdxbdy = cdx * bdy;
+        double cdxady = cdx * ady, adxcdy = adx * cdy;
+        double adxbdy = adx * bdy, bdxady = bdx * ady;
+        double det = adz * ( bdxcdy - cdxbdy) + bdz * ( cdxady - adxcdy)
+                   + cdz * ( adxbdy - bdxady);
+        double permanent = ( std::fabs( bdxcdy) + std::fabs( cdxbdy)) * std::fabs( adz)
+                         + ( std::fabs( cdxady) + std::fabs( adxcdy)) * std::fabs( bdz)
+                         + ( std::fabs( adxbdy) + std::fabs( bdxady)) * std::fabs( cdz);
+        double bound = 7.7715611723761027e-16 * permanent
+                     + (std::numeric_limits<double>::min)();
+        return( det > bound ? 1 : ( det < -bound ? -1 : 0));
+    }
+
+    inline
+    void
+    coordinates( std::size_t i, double* p) const
+    {
+        p[ 0] = point_x[ i]; p[ 1] = point_y[ i]; p[ 2] = point_z[ i];
+    }
+
+    void
+    load_coordinates( )
+    {
+        point_x.resize( points.size());
+        point_y.resize( points.size());
+        point_z.resize( points.size());
+        for ( std::size_t i = 0; i < points.size(); ++i) {
+            point_x[ i] = CGAL::to_double( points[ i].x());
+            point_y[ i] = CGAL::to_double( points[ i].y());
+            point_z[ i] = CGAL::to_double( points[ i].z());
+        }
+    }
+
+    // (p-c)^T S^-1 (p-c) of points[ i]
+    inline
+    double
+    distance( std::size_t i) const
+    {
+        double dx = point_x[ i] - center[ 0];
+        double dy = point_y[ i] - center[ 1];
+        double dz = point_z[ i] - center[ 2];
+        return( s_inv[ 0] * dx * dx + s_inv[ 3] * dy * dy + s_inv[ 5] * dz * dz
+                + 2 * ( s_inv[ 1] * dx * dy + s_inv[ 2] * dx * dz + s_inv[ 4] * dy * dz));
+    }
+
+    // index of the point maximizing d^T p, the first one on ties
+    std::size_t
+    extreme_point( double dx, double dy, double dz) const
+    {
+        std::size_t i, best = 0;
+        double value = -HUGE_VAL;
+        for ( i = 0; i < points.size(); ++i) {
+            double v = dx * point_x[ i] + dy * point_y[ i] + dz * point_z[ i];
+            if ( v > value) {
+                value = v;
+                best = i;
+            }
+        }
+        return( best);
+    }
+
+    void
+    add_to_working_set( std::size_t i)
+    {
+        if ( std::find( working.begin(), working.end(), i) == working.end()) {
+            working.push_back( i);
+            weight.push_back( 0);
+        }
+    }
+
+    // center and inverse scatter matrix of the weights; false if the
+    // scatter matrix is singular
+    bool
+    update_center( )
+    {
+        double c[ 3] = { 0, 0, 0 }, s[ 6] = { 0, 0, 0, 0, 0, 0 };
+        std::size_t j;
+        for ( j = 0; j < working.size(); ++j) {
+            c[ 0] += weight[ j] * point_x[ working[ j]];
+            c[ 1] += weight[ j] * point_y[ working[ j]];
+            c[ 2] += weight[ j] * point_z[ working[ j]];
+        }
+        for ( j = 0; j < working.size(); ++j) {
+            double dx = point_x[ working[ j]] - c[ 0];
+            double dy = point_y[ working[ j]] - c[ 1];
+            double dz = point_z[ working[ j]] - c[ 2];
+            s[ 0] += weight[ j] * dx * dx; s[ 1] += weight[ j] * dx * dy;
+            s[ 2] += weight[ j] * dx * dz; s[ 3] += weight[ j] * dy * dy;
+            s[ 4] += weight[ j] * dy * dz; s[ 5] += weight[ j] * dz * dz;
+        }
+
+        // inverse by the adjugate
+        double a11 = s[ 3] * s[ 5] - s[ 4] * s[ 4];
+        double a12 = s[ 2] * s[ 4] - s[ 1] * s[ 5];
+        double a13 = s[ 1] * s[ 4] - s[ 2] * s[ 3];
+        double det = s[ 0] * a11 + s[ 1] * a12 + s[ 2] * a13;
+        if ( !( det > 0))
+            return( false);
+        s_inv[ 0] = a11 / det;
+        s_inv[ 1] = a12 / det;
+        s_inv[ 2] = a13 / det;
+        s_inv[ 3] = ( s[ 0] * s[ 5] - s[ 2] * s[ 2]) / det;
+        s_inv[ 4] = ( s[ 1] * s[ 2] - s[ 0] * s[ 4]) / det;
+        s_inv[ 5] = ( s[ 0] * s[ 3] - s[ 1] * s[ 1]) / det;
+        std::copy( c, c + 3, center);
+        return( true);
+    }
+
+    // optimize the weights until every working set point is within the
+    // given distance. The lifted points (p, 1) have q^T M^-1 q =
+    // distance + 1 and the lifted dimension is 4.
+    bool
+    optimize_working_set( double limit)
+    {
+        const double n = 4;
+        for ( std::size_t it = 0; it < max_iterations; ++it) {
+            if ( !update_center())
+                return( false);
+
+            std::size_t j, up = 0, down = working.size();
+            double k_up = -HUGE_VAL, k_down = HUGE_VAL;
+            for ( j = 0; j < working.size(); ++j) {
+                double k = distance( working[ j]) + 1;
+                if ( k > k_up) { k_up = k; up = j; }
+                if ( weight[ j] > 0 && k < k_down) { k_down = k; down = j; }
+            }
+            if ( k_up - 1 <= limit)
+                return( true);
+            ++n_iterations;
+
+            // toward step on the farthest point, or away step from the
+            // nearest weighted point if that one is further off
+            if ( down == working.size() || k_up / n - 1 >= 1 - k_down / n) {
+                double beta = ( k_up - n) / ( n * ( k_up - 1));
+                for ( j = 0; j < working.size(); ++j)
+                    weight[ j] *= 1 - beta;
+                weight[ up] += beta;
+            } else {
+                double beta = ( n - k_down) / ( n * ( k_down - 1));
+                if ( weight[ down] < 1)
+                    beta = (std::min)( beta, weight[ down] / ( 1 - weight[ down]));
+                for ( j = 0; j < working.size(); ++j)
+                    weight[ j] *= 1 + beta;
+                weight[ down] -= beta;
+                if ( weight[ down] < 0)
+                    weight[ down] = 0;
+            }
+        }
+        return( update_center());
+    }
+
+    // initial working set: the extreme points along the axes, extended by
+    // points spanning the space if they are coplanar. Returns false if all
+    // points are coplanar.
+    bool
+    initialize_working_set( )
+    {
+        double a[ 3], b[ 3], c[ 3], p[ 3];
+        std::size_t i, ia, ib, ic, id;
+
+        working.clear();
+        weight.clear();
+        add_to_working_set( extreme_point(  1, 0, 0));
+        add_to_working_set( extreme_point( -1, 0, 0));
+        add_to_working_set( extreme_point( 0,  1, 0));
+        add_to_working_set( extreme_point( 0, -1, 0));
+        add_to_working_set( extreme_point( 0, 0,  1));
+        add_to_working_set( extreme_point( 0, 0, -1));
+        weight.assign( working.size(), 1.0 / working.size());
+        if ( update_center())
+            return( true);
+
+        // a tetrahedron of maximal volume, greedily
+        ia = working[ 0];
+        ib = ia;
+        double best = 0;
+        coordinates( ia, a);
+        for ( i = 0; i < points.size(); ++i) {
+            coordinates( i, p);
+            double d = ( p[ 0] - a[ 0]) * ( p[ 0] - a[ 0]) + ( p[ 1] - a[ 1]) * ( p[ 1] - a[ 1])
+                     + ( p[ 2] - a[ 2]) * ( p[ 2] - a[ 2]);
+            if ( d > best) { best = d; ib = i; }
+        }
+        coordinates( ib, b);
+        ic = ib;
+        best = 0;
+        for ( i = 0; i < points.size(); ++i) {
+            coordinates( i, p);
+            double ux = b[ 0] - a[ 0], uy = b[ 1] - a[ 1], uz = b[ 2] - a[ 2];
+            double vx = p[ 0] - a[ 0], vy = p[ 1] - a[ 1], vz = p[ 2] - a[ 2];
+            double cx = uy * vz - uz * vy, cy = uz * vx - ux * vz, cz = ux * vy - uy * vx;
+            double d = cx * cx + cy * cy + cz * cz;
+            if ( d > best) { best = d; ic = i; }
+        }
+        coordinates( ic, c);
+        id = ic;
+        for ( i = 0; i < points.size(); ++i) {
+            coordinates( i, p);
+            if ( orientation( a, b, c, p) != 0) {
+                id = i;
+                break;
+            }
+        }
+        if ( id == ic)
+            return( false);
+
+        add_to_working_set( ia);
+        add_to_working_set( ib);
+        add_to_working_set( ic);
+        add_to_working_set( id);
+        weight.assign( working.size(), 1.0 / working.size());
+        return( update_center());
+    }
+
+    // support points: the heaviest points of the working set, and the
+    // facets of their convex hull
+    void
+    update_support( )
+    {
+        std::vector< std::pair< double, std::size_t> > order;
+        std::size_t j;
+        int i, k, l, m;
+
+        for ( j = 0; j < working.size(); ++j)
+            if ( weight[ j] > 0)
+                order.push_back( std::make_pair( -weight[ j], working[ j]));
+        std::sort( order.begin(), order.end());
+        n_support_points = (std::min)( int( order.size()), int( max_support_points));
+        for ( i = 0; i < n_support_points; ++i) {
+            support_ids[ i] = order[ i].second;
+            coordinates( support_ids[ i], support_xyz[ i]);
+        }
+
+        // a triple is a facet if all other support points are certainly
+        // on one side of it; give up on any uncertain test
+        n_facets = 0;
+        if ( !options.use_convex_hull_heuristic || n_support_points < 4)
+            return;
+        for ( i = 0; i < n_support_points; ++i)
+            for ( k = i+1; k < n_support_points; ++k)
+                for ( l = k+1; l < n_support_points; ++l) {
+                    int positive = 0, negative = 0;
+                    for ( m = 0; m < n_support_points; ++m) {
+                        if ( m == i || m == k || m == l)
+                            continue;
+                        int o = orientation( support_xyz[ i], support_xyz[ k],
+                                             support_xyz[ l], support_xyz[ m]);
+                        if ( o == 0) {
+                            n_facets = 0;
+                            return;
+                        }
+                        if ( o > 0) ++positive; else ++negative;
+                    }
+                    if ( positive > 0 && negative > 0)
+                        continue;
+                    if ( n_facets == max_facets) {
+                        n_facets = 0;
+                        return;
+                    }
+                    facets[ n_facets][ 0] = i;
+                    facets[ n_facets][ 1] = k;
+                    facets[ n_facets][ 2] = l;
+                    facet_side[ n_facets] = positive > 0 ? 1 : -1;
+                    ++n_facets;
+                }
+    }
+
+    // points[ i] certainly in the interior of the support hull?
+    inline
+    bool
+    is_dominated( std::size_t i) const
+    {
+        if ( n_facets == 0)
+            return( false);
+        double p[ 3];
+        coordinates( i, p);
+        for ( int f = 0; f < n_facets; ++f)
+            if ( orientation( support_xyz[ facets[ f][ 0]],
+                              support_xyz[ facets[ f][ 1]],
+                              support_xyz[ facets[ f][ 2]], p) != facet_side[ f])
+                return( false);
+        return( true);
+    }
+
+    // extend the working set by points[ i] and recompute
+    void
+    update_ellipsoid( std::size_t i)
+    {
+        add_to_working_set( i);
+        ++n_updates;
+        optimize_working_set( core_limit());
+        update_support();
+    }
+
+    double
+    limit( ) const
+    {
+        return( 3 * ( 1 + options.epsilon) * ( 1 + options.epsilon));
+    }
+
+    // the working set is optimized a little further than the other points
+    // are tested, so that a recomputation rarely causes another pass
+    double
+    core_limit( ) const
+    {
+        return( 3 * ( 1 + options.epsilon / 2) * ( 1 + options.epsilon / 2));
+    }
+
+    void
+    move_to_front( std::size_t i)
+    {
+        if ( i == 0)
+            return;
+        std::rotate( points.begin(), points.begin() + i, points.begin() + i+1);
+        std::rotate( point_x.begin(), point_x.begin() + i, point_x.begin() + i+1);
+        std::rotate( point_y.begin(), point_y.begin() + i, point_y.begin() + i+1);
+        std::rotate( point_z.begin(), point_z.begin() + i, point_z.begin() + i+1);
+        for ( std::size_t j = 0; j < working.size(); ++j)
+            if ( working[ j] == i)
+                working[ j] = 0;
+            else if ( working[ j] < i)
+                ++working[ j];
+    }
+
+    void
+    me_with_convex_hull_heuristic( )
+    {
+        const double outside = limit();
+        std::size_t n_alive = points.size(), i, j, n_kept;
+        bool outlier = true;
+
+        survivors.resize( n_alive);
+        for ( i = 0; i < n_alive; ++i)
+            survivors[ i] = i;
+
+        while ( outlier) {
+            outlier = false;
+            ++n_passes;
+            for ( j = 0, n_kept = 0; j < n_alive; ++j) {
+                i = survivors[ j];
+                if ( distance( i) > outside) {
+                    update_ellipsoid( i);
+                    outlier = true;
+                }
+                else if ( is_dominated( i))
+                    continue;
+                survivors[ n_kept++] = i;
+            }
+            n_alive = n_kept;
+        }
+        survivors.clear();
+    }
+
+    void
+    me( )
+    {
+        const double outside = limit();
+        std::size_t i, n = points.size();
+        bool outlier = true;
+
+        while ( outlier) {
+            outlier = false;
+            ++n_passes;
+            for ( i = 0; i < n; ++i)
+                if ( distance( i) > outside) {
+                    update_ellipsoid( i);
+                    move_to_front( i);
+                    outlier = true;
+                }
+        }
+        // the support ids refer to the final positions
+        update_support();
+    }
+
+    void
+    compute( )
+    {
+        n_support_points = 0;
+        n_facets = 0;
+        coplanar = points.size() < 4;
+        if ( points.empty())
+            return;
+
+        load_coordinates();
+        if ( !initialize_working_set()) {
+            coplanar = true;
+            update_support();
+            return;
+        }
+        if ( !optimize_working_set( core_limit())) {
+            update_support();
+            return;
+        }
+        update_support();
+
+        if ( options.use_convex_hull_heuristic)
+            me_with_convex_hull_heuristic();
+        else
+            me();
+
+        Ellipsoid& e = current_ellipsoid;
+        double f = 1 / ( limit() * ( 1 + 1e-12));
+        e.degenerate = false;
+        std::copy( center, center + 3, e.center);
+        for ( int k = 0; k < 6; ++k)
+            e.m[ k] = s_inv[ k] * f;
+    }
+
+  public:
+    // Constructors
+    // ------------
+    template < class InputIterator >
+    Min_ellipsoid_3_rublev( InputIterator first,
+                            InputIterator last,
+                            const Options& solver_options = Options())
+        : options( solver_options), n_support_points( 0), n_facets( 0),
+          coplanar( true), n_passes( 0), n_updates( 0), n_iterations( 0)
+    {
+        CGAL_optimisation_precondition( options.epsilon > 0);
+        std::copy( first, last, std::back_inserter( points));
+        compute();
+    }
+
+    // Validity check
+    // --------------
+    // every point inside the ellipsoid, or no ellipsoid for coplanar points
+    bool
+    is_valid( ) const
+    {
+        if ( current_ellipsoid.is_degenerate())
+            return( coplanar);
+        for ( std::size_t i = 0; i < points.size(); ++i)
+            if ( current_ellipsoid.bounded_side( point_x[ i], point_y[ i],
+                                                 point_z[ i]) == ON_UNBOUNDED_SIDE)
+                return( false);
+        return( true);
+    }
+};
+
+} //namespace CGAL
+
+#endif // CGAL_MIN_ELLIPSOID_3_RUBLEV_H
+
+// ===== EOF =================================================================
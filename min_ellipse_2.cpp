@@ -3,170 +3,974 @@
 #include <CGAL/Simple_cartesian.h>
 #include <CGAL/Gmpq.h>
 #include <CGAL/point_generators_2.h>
+#include <CGAL/point_generators_3.h>
 #include <CGAL/generators.h>
 
 #include <CGAL/Min_ellipse_2.h>
 #include "Min_ellipse_2_rublev.h"
 #include "Min_ellipse_2_rublev_lp_solver.h"
+#include "Min_ellipse_2_rublev_batch.h"
+#include "Min_ellipse_2_rublev_window.h"
+#include "Min_ellipse_2_rublev_gmp_pool.h"
+#include "Min_ellipse_2_khachiyan.h"
+#include "Min_ellipsoid_3_rublev.h"
+#include "Mapped_point_file_2.h"
 
 #include <CGAL/Min_ellipse_2_traits_2.h>
 
+#include <gmp.h>
+
 #include <vector>
 #include <cmath>
-#include <ctime>
-#include <cassert>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
 #include <string>
+#include <sstream>
+#include <fstream>
+#include <iostream>
+#include <iomanip>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <new>
+
+#if defined( _WIN32)
+#include <windows.h>
+#include <psapi.h>
+#if defined( _MSC_VER)
+#pragma comment( lib, "psapi.lib")
+#endif
+#else
+#include <sys/resource.h>
+#endif
 
 typedef  CGAL::Gmpq                       NT;
 typedef  CGAL::Cartesian<NT>              K;
 typedef  CGAL::Cartesian_d<NT>			  Kernel_d;
 typedef  CGAL::Point_2<K>                 Point;
+typedef  K::Point_3                       Point_3;
 typedef  CGAL::Min_ellipse_2_traits_2<K>  Traits;
 typedef  CGAL::Point_d<Kernel_d>		  Point_d;
 
+typedef  CGAL::Min_ellipse_2_rublev< Traits>  Rublev;
+typedef  CGAL::Mapped_point_file_2< Point>  Point_file;
+
+// Heap accounting
+// ===============
+// Every operator new and every GMP allocation is counted, so that the peak
+// number of live heap bytes during a single computation can be reported.
+
+static std::atomic< std::size_t> heap_current( 0);
+static std::atomic< std::size_t> heap_peak( 0);
+
+static void
+heap_allocated( std::size_t n)
+{
+	std::size_t now = heap_current += n;
+	std::size_t peak = heap_peak.load();
+	while ( now > peak && !heap_peak.compare_exchange_weak( peak, now))
+		;
+}
+
+static void
+heap_freed( std::size_t n)
+{
+	heap_current -= n;
+}
+
+// start a new measurement; returns the baseline
+static std::size_t
+heap_reset_peak( )
+{
+	std::size_t now = heap_current.load();
+	heap_peak.store( now);
+	return now;
+}
+
+// operator new keeps the block size in front of the block
+static const std::size_t heap_header = 16;
+
+void*
+operator new( std::size_t n)
+{
+	char* p = static_cast< char*>( std::malloc( n + heap_header));
+	if ( !p)
+		throw std::bad_alloc();
+	*reinterpret_cast< std::size_t*>( p) = n;
+	heap_allocated( n);
+	return p + heap_header;
+}
+
 void
-test_mve()
-{
-	int N, distribution, i;
-	std::vector<long> sum, sum2;
-	std::vector<double> M, M2;
-	long prev_verbose_time, t;
-	int iterations;
-	std::list< Point> points;
-	bool test_validness;
-	std::string test_validness_s;
-
-	const int num_of_methods = 4;
-
-	sum.resize(num_of_methods, 0);
-	sum2.resize(num_of_methods, 0);
-	M.resize(num_of_methods, 0);
-	M2.resize(num_of_methods, 0);
-
-	std::cout << "Please, choose a distribution:\n" <<
-		"\t1. in_square\n" <<
-		"\t2. in_disk\n" <<
-		"\t3. on_circle\n" <<
-		"\t4. on_square\n";
-	std::cin >> distribution;
-	assert(distribution > 0 && distribution < 5);
-
-	std::cout << "Please, enter N: ";
-	std::cin >> N;
-	assert(N > 0 && N < 1000000);
-
-	std::cout << "Test validness ? (Y/n)";
-	std::cin >> test_validness_s;
-	if (test_validness_s.length() > 0 && (test_validness_s[0] == 'Y' || test_validness_s[0] == 'y'))
-		test_validness = true;
-	else
-		test_validness = false;
+operator delete( void* q) throw()
+{
+	if ( !q)
+		return;
+	char* p = static_cast< char*>( q) - heap_header;
+	heap_freed( *reinterpret_cast< std::size_t*>( p));
+	std::free( p);
+}
 
+void* operator new[]( std::size_t n) { return operator new( n); }
+void operator delete[]( void* q) throw() { operator delete( q); }
+void operator delete( void* q, std::size_t) throw() { operator delete( q); }
+void operator delete[]( void* q, std::size_t) throw() { operator delete( q); }
 
-//	std::cout << "        |             CGAL              |         rublev_fast\n";
-//	std::cout << " Iter's |     median    |    std dev    |     median    |    std dev\n";
-	std::cout << " Iter's |     rublev    |rublev_lp_solve|      CGAL     |rublev_convex_hull\n";
+static void*
+gmp_allocate( std::size_t n)
+{
+	heap_allocated( n);
+	return std::malloc( n);
+}
 
-	iterations = 0;
-	prev_verbose_time = 0;
-	while ( true) {
-		iterations ++;
-		points.clear();
+static void*
+gmp_reallocate( void* p, std::size_t old_n, std::size_t new_n)
+{
+	heap_freed( old_n);
+	heap_allocated( new_n);
+	return std::realloc( p, new_n);
+}
 
-		if ( distribution == 1) {
-			CGAL::Random_points_in_square_2< Point> generator(100.0);
-			for ( i = 0; i < N; ++i)
-				points.push_back( *( ++generator));
-		}
-		else if ( distribution == 2) {
-			CGAL::Random_points_in_disc_2< Point> generator(100.0);
-			for ( i = 0; i < N; ++i)
-				points.push_back( *( ++generator));
+static void
+gmp_free( void* p, std::size_t n)
+{
+	heap_freed( n);
+	std::free( p);
+}
+
+// peak resident set size of the process in kilobytes
+static long
+peak_rss_kb( )
+{
+#if defined( _WIN32)
+	PROCESS_MEMORY_COUNTERS pmc;
+	if ( GetProcessMemoryInfo( GetCurrentProcess(), &pmc, sizeof( pmc)))
+		return long( pmc.PeakWorkingSetSize / 1024);
+	return 0;
+#else
+	struct rusage usage;
+	getrusage( RUSAGE_SELF, &usage);
+#if defined( __APPLE__)
+	return usage.ru_maxrss / 1024;
+#else
+	return usage.ru_maxrss;
+#endif
+#endif
+}
+
+// Methods and distributions
+// =========================
+
+static const char* method_names[] = {
+	"rublev", "rublev_lp_solve", "cgal", "rublev_convex_hull",
+	"rublev_parallel", "rublev_streaming", "rublev_batch",
+	"rublev_hull_first", "khachiyan", "rublev_3", "welzl_3", "rublev_view",
+	"rublev_window", "rublev_divide" };
+static const int num_of_methods = 14;
+
+// the 3D methods run on point sets in three dimensions
+static bool
+is_3d_method( int method)
+{
+	return method == 9 || method == 10;
+}
+
+// the last name stands for the points of an --input file and is not
+// selectable with --dist
+static const char* distribution_names[] = {
+	"in_square", "in_disc", "on_circle", "on_square", "file" };
+static const int num_of_distributions = 4;
+static const int file_distribution = 4;
+
+// solver statistics reported for the Rublev methods
+static const char* counter_names[] = {
+	"constructions_3", "constructions_4", "constructions_5", "memo_hits",
+	"max_support_depth", "exact_ellipse_tests", "exact_hull_tests",
+	"hull_rejections" };
+static const int num_of_counters = 8;
+
+static const char* strategy_names[] = {
+	"restart", "move_to_front", "pivoting" };
+
+static void
+generate_points( int distribution, int N, unsigned int seed,
+				 std::vector< Point>& points)
+{
+	CGAL::Random random( seed);
+	int i;
+
+	points.clear();
+	points.reserve( N);
+	if ( distribution == 0) {
+		CGAL::Random_points_in_square_2< Point> generator( 100.0, random);
+		for ( i = 0; i < N; ++i, ++generator)
+			points.push_back( *generator);
+	}
+	else if ( distribution == 1) {
+		CGAL::Random_points_in_disc_2< Point> generator( 100.0, random);
+		for ( i = 0; i < N; ++i, ++generator)
+			points.push_back( *generator);
+	}
+	else if ( distribution == 2) {
+		CGAL::Random_points_on_circle_2< Point> generator( 100.0, random);
+		for ( i = 0; i < N; ++i, ++generator)
+			points.push_back( *generator);
+	}
+	else {
+		CGAL::Random_points_on_square_2< Point> generator( 100.0, random);
+		for ( i = 0; i < N; ++i, ++generator)
+			points.push_back( *generator);
+	}
+}
+
+// the 3D counterparts of the distributions: in a cube, in a ball, on a
+// sphere and on the surface of a cube
+static void
+generate_points_3( int distribution, int N, unsigned int seed,
+				   std::vector< Point_3>& points)
+{
+	CGAL::Random random( seed);
+	int i;
+
+	points.clear();
+	points.reserve( N);
+	if ( distribution == 1) {
+		CGAL::Random_points_in_sphere_3< Point_3> generator( 100.0, random);
+		for ( i = 0; i < N; ++i, ++generator)
+			points.push_back( *generator);
+	}
+	else if ( distribution == 2) {
+		CGAL::Random_points_on_sphere_3< Point_3> generator( 100.0, random);
+		for ( i = 0; i < N; ++i, ++generator)
+			points.push_back( *generator);
+	}
+	else {
+		CGAL::Random_points_in_cube_3< Point_3> generator( 100.0, random);
+		for ( i = 0; i < N; ++i, ++generator) {
+			Point_3 p = *generator;
+			if ( distribution == 3) {
+				// push the largest coordinate onto its face
+				double c[ 3] = { CGAL::to_double( p.x()), CGAL::to_double( p.y()),
+								 CGAL::to_double( p.z()) };
+				int axis = std::fabs( c[ 0]) > std::fabs( c[ 1]) ? 0 : 1;
+				if ( std::fabs( c[ 2]) > std::fabs( c[ axis]))
+					axis = 2;
+				c[ axis] = c[ axis] < 0 ? -100.0 : 100.0;
+				p = Point_3( c[ 0], c[ 1], c[ 2]);
+			}
+			points.push_back( p);
 		}
-		else if ( distribution == 3) {
-			CGAL::Random_points_on_circle_2< Point> generator(100.0);
-			for ( i = 0; i < N; ++i)
-				points.push_back( *( ++generator));
+	}
+}
+
+// Benchmark
+// =========
+
+struct Settings {
+	std::vector< int>  methods;
+	std::vector< int>  distributions;
+	std::vector< int>  sizes;
+	int                repetitions;
+	unsigned int       seed;
+	int                threads;
+	int                cluster_size;
+	int                window;
+	Rublev::Update_strategy strategy;
+	bool               shuffle;
+	int                prefilter;
+	double             epsilon;
+	bool               gmp_pool;
+	bool               validate;
+	std::string        format;
+	std::string        output;
+	std::string        input;
+	Point_file::Format input_format;
+
+	Settings( )
+		: repetitions( 5), seed( 1), threads( 0), cluster_size( 100),
+		  window( 1000),
+		  strategy( Rublev::RESTART_UPDATES), shuffle( false), prefilter( 0),
+		  epsilon( 1e-3), gmp_pool( false),
+		  validate( false),
+		  format( "csv")
+	{ }
+};
+
+// measurements of one computation
+struct Run {
+	double       seconds;
+	std::size_t  peak_heap;
+	int          support_points;
+	std::size_t  passes, updates;               // Rublev methods; scans and
+	                                            // iterations of khachiyan;
+	                                            // solves and dropped points
+	                                            // of rublev_window
+	double       prefilter_ratio;
+	double       counters[ num_of_counters];
+	bool         valid;
+};
+
+// measurements of all repetitions of one method on one distribution and N
+struct Result {
+	int                  method, distribution, N;
+	std::vector< Run>    runs;
+};
+
+typedef std::chrono::steady_clock Clock;
+
+static double
+seconds_since( Clock::time_point start)
+{
+	return std::chrono::duration< double>( Clock::now() - start).count();
+}
+
+template < class Solver >
+static void
+finish_run( const Solver& me, const Settings& settings, Run& run)
+{
+	run.support_points = me.number_of_support_points();
+	run.valid = !settings.validate || me.is_valid( false);
+}
+
+static void
+count_updates( const Rublev& me, Run& run)
+{
+	run.passes = me.number_of_passes();
+	run.updates = me.number_of_updates();
+	run.prefilter_ratio = me.prefilter_reduction_ratio();
+
+	const Rublev::Statistics& stats = me.statistics();
+	double counters[ num_of_counters] = {
+		double( stats.ellipse_constructions[ 3]),
+		double( stats.ellipse_constructions[ 4]),
+		double( stats.ellipse_constructions[ 5]),
+		double( stats.memo_hits),
+		double( stats.max_support_depth),
+		double( stats.exact_ellipse_tests),
+		double( stats.exact_hull_tests),
+		double( stats.hull_rejections) };
+	std::copy( counters, counters + num_of_counters, run.counters);
+}
+
+// options of the single set Rublev methods
+static Rublev::Options
+rublev_options( int method, const Settings& settings)
+{
+	Rublev::Options options;
+	options.use_convex_hull_heuristic = method != 0;
+	options.parallel = method == 4 || method == 7;
+	options.hull_first = method == 7;
+	options.divide_and_conquer = method == 13;
+	options.n_threads = settings.threads;
+	options.update_strategy = settings.strategy;
+	options.random_permutation = settings.shuffle;
+	options.random_seed = settings.seed;
+	options.prefilter_directions = settings.prefilter;
+	return options;
+}
+
+// the view of rublev_convex_hull needs an array of points; the points of
+// a file are copied for it
+static const std::vector< Point>&
+point_array( const std::vector< Point>& points, std::vector< Point>&)
+{
+	return points;
+}
+
+static const std::vector< Point>&
+point_array( const Point_file& points, std::vector< Point>& copy)
+{
+	copy.assign( points.begin(), points.end());
+	return copy;
+}
+
+// Points is std::vector< Point> or Point_file; the solvers read a file
+// through its iterators, without a copy
+template < class Points >
+static Run
+run_method( int method, const Points& points,
+			const std::vector< Point_3>& points_3, const Settings& settings)
+{
+	Run run;
+	run.passes = run.updates = 0;
+	run.prefilter_ratio = 0;
+	std::fill( run.counters, run.counters + num_of_counters, 0.0);
+	std::vector< Point> copy;
+	const std::vector< Point>& array =
+		method == 11 ? point_array( points, copy) : copy;
+	std::size_t baseline = heap_reset_peak();
+	Clock::time_point start = Clock::now();
+
+	if ( method == 0 || method == 3 || method == 4 || method == 7 || method == 13) {
+		Rublev me( points.begin(), points.end(), rublev_options( method, settings));
+		run.seconds = seconds_since( start);
+		run.peak_heap = heap_peak.load() - baseline;
+		finish_run( me, settings, run);
+		count_updates( me, run);
+		// only the hull vertices are retained; check all points
+		if ( method == 7 && settings.validate)
+			for ( std::size_t i = 0; i < points.size(); ++i)
+				run.valid = run.valid && !me.has_on_unbounded_side( points[ i]);
+	}
+	else if ( method == 11) {
+		// rublev_convex_hull on the benchmark's points instead of a copy
+		Rublev me( array.data(), array.data() + array.size(),
+				   Rublev::View_tag(), rublev_options( method, settings));
+		run.seconds = seconds_since( start);
+		run.peak_heap = heap_peak.load() - baseline;
+		finish_run( me, settings, run);
+		count_updates( me, run);
+	}
+	else if ( method == 12) {
+		// slide a window of the given length over the points
+		CGAL::Min_ellipse_2_rublev_window< Traits> window;
+		for ( std::size_t i = 0; i < points.size(); ++i) {
+			window.push_back( points[ i]);
+			if ( window.number_of_points() > std::size_t( settings.window))
+				window.pop_front();
 		}
-		else if ( distribution == 4) {
-			CGAL::Random_points_on_square_2< Point> generator(100.0);
-			for ( i = 0; i < N; ++i)
-				points.push_back( *( ++generator));
+		run.seconds = seconds_since( start);
+		run.peak_heap = heap_peak.load() - baseline;
+		run.support_points = window.number_of_support_points();
+		run.passes = window.number_of_solves();
+		run.updates = window.number_of_dropped_points();
+		run.valid = true;
+		if ( settings.validate)
+			for ( std::size_t i = points.size() - window.number_of_points();
+				  i < points.size(); ++i)
+				run.valid = run.valid && !window.has_on_unbounded_side( points[ i]);
+	}
+	else if ( method == 1) {
+		CGAL::Min_ellipse_2_rublev_lp_solver< Traits> me( points.begin(), points.end());
+		run.seconds = seconds_since( start);
+		run.peak_heap = heap_peak.load() - baseline;
+		finish_run( me, settings, run);
+	}
+	else if ( method == 2) {
+		CGAL::Min_ellipse_2< Traits> me( points.begin(), points.end());
+		run.seconds = seconds_since( start);
+		run.peak_heap = heap_peak.load() - baseline;
+		finish_run( me, settings, run);
+	}
+	else if ( is_3d_method( method)) {
+		CGAL::Min_ellipsoid_3_rublev< K>::Options options;
+		options.use_convex_hull_heuristic = method == 9;
+		options.epsilon = settings.epsilon;
+		CGAL::Min_ellipsoid_3_rublev< K> me( points_3.begin(), points_3.end(),
+											 options);
+		run.seconds = seconds_since( start);
+		run.peak_heap = heap_peak.load() - baseline;
+		run.support_points = me.number_of_support_points();
+		run.passes = me.number_of_passes();
+		run.updates = me.number_of_updates();
+		run.valid = !settings.validate || me.is_valid();
+	}
+	else if ( method == 8) {
+		CGAL::Min_ellipse_2_khachiyan< Traits> me(
+			points.begin(), points.end(), settings.epsilon);
+		run.seconds = seconds_since( start);
+		run.peak_heap = heap_peak.load() - baseline;
+		run.support_points = me.number_of_support_points();
+		run.passes = me.number_of_scans();
+		run.updates = me.number_of_iterations();
+		run.valid = !settings.validate || me.is_converged();
+		if ( settings.validate)
+			for ( std::size_t i = 0; i < points.size(); ++i)
+				run.valid = run.valid && !me.ellipse().has_on_unbounded_side( points[ i]);
+	}
+	else if ( method == 6) {
+		// consecutive clusters of cluster_size points
+		std::vector< std::size_t> offsets;
+		for ( std::size_t i = 0; i < points.size(); i += settings.cluster_size)
+			offsets.push_back( i);
+		offsets.push_back( points.size());
+		CGAL::Min_ellipse_2_rublev_batch< Traits> batch(
+			points.begin(), offsets.begin(), offsets.end(),
+			Rublev::Options(), settings.threads);
+		run.seconds = seconds_since( start);
+		run.peak_heap = heap_peak.load() - baseline;
+		run.support_points = 0;
+		run.valid = true;
+		for ( std::size_t c = 0; c < batch.number_of_sets(); ++c) {
+			run.support_points += batch.number_of_support_points( c);
+			if ( !settings.validate)
+				continue;
+			for ( std::size_t i = offsets[ c]; i < offsets[ c+1]; ++i)
+				run.valid = run.valid
+					&& !batch.ellipse( c).has_on_unbounded_side( points[ i]);
+			for ( int j = 0; j < batch.number_of_support_points( c); ++j)
+				run.valid = run.valid && batch.ellipse( c).has_on_boundary(
+					points[ batch.support_point_index( c, j)]);
 		}
+	}
+	else {
+		Rublev::Options options;
+		options.streaming = true;
+		Rublev me( options);
+		for ( std::size_t i = 0; i < points.size(); ++i)
+			me.insert( points[ i]);
+		run.seconds = seconds_since( start);
+		run.peak_heap = heap_peak.load() - baseline;
+		finish_run( me, settings, run);
+		count_updates( me, run);
+	}
+	return run;
+}
 
-		{
-			t = clock();
-			CGAL::Min_ellipse_2_rublev< Traits>  me( points.begin(), points.end(), false);
-			t = clock() - t;
-			sum[ 0] += t;
-			sum2[ 0] += t*t;
-			if (test_validness)
-			{
-				if ( !me.is_valid( false))
-					me.is_valid( true);
-			}
+// q-quantile of sorted values, linearly interpolated
+static double
+quantile( const std::vector< double>& sorted, double q)
+{
+	double position = q * ( sorted.size() - 1);
+	std::size_t i = std::size_t( position);
+	if ( i + 1 >= sorted.size())
+		return sorted.back();
+	return sorted[ i] + ( position - i) * ( sorted[ i + 1] - sorted[ i]);
+}
+
+struct Summary {
+	double       median, p10, p90, min, max, mean;
+	double       passes, updates, prefilter_ratio;  // medians
+	double       counters[ num_of_counters];        // medians
+	std::size_t  peak_heap;
+	int          support_points;
+	bool         valid;
+};
+
+static Summary
+summarize( const Result& result)
+{
+	Summary s;
+	std::vector< double> ms, passes, updates, ratios;
+	std::size_t i;
+
+	s.mean = 0;
+	s.peak_heap = 0;
+	s.valid = true;
+	for ( i = 0; i < result.runs.size(); ++i) {
+		ms.push_back( result.runs[ i].seconds * 1000.0);
+		passes.push_back( double( result.runs[ i].passes));
+		updates.push_back( double( result.runs[ i].updates));
+		ratios.push_back( result.runs[ i].prefilter_ratio);
+		s.mean += ms.back();
+		s.peak_heap = (std::max)( s.peak_heap, result.runs[ i].peak_heap);
+		s.valid = s.valid && result.runs[ i].valid;
+	}
+	s.mean /= ms.size();
+	s.support_points = result.runs.back().support_points;
+
+	std::sort( passes.begin(), passes.end());
+	std::sort( updates.begin(), updates.end());
+	std::sort( ratios.begin(), ratios.end());
+	for ( int c = 0; c < num_of_counters; ++c) {
+		std::vector< double> values;
+		for ( i = 0; i < result.runs.size(); ++i)
+			values.push_back( result.runs[ i].counters[ c]);
+		std::sort( values.begin(), values.end());
+		s.counters[ c] = quantile( values, 0.5);
+	}
+	s.passes = quantile( passes, 0.5);
+	s.updates = quantile( updates, 0.5);
+	s.prefilter_ratio = quantile( ratios, 0.5);
+
+	std::sort( ms.begin(), ms.end());
+	s.median = quantile( ms, 0.5);
+	s.p10 = quantile( ms, 0.1);
+	s.p90 = quantile( ms, 0.9);
+	s.min = ms.front();
+	s.max = ms.back();
+	return s;
+}
+
+static void
+write_csv( std::ostream& out, const std::vector< Result>& results)
+{
+	out << "method,distribution,n,repetitions,median_ms,p10_ms,p90_ms,"
+		<< "min_ms,max_ms,mean_ms,peak_heap_bytes,support_points,passes,updates,"
+		<< "prefilter_ratio,";
+	for ( int c = 0; c < num_of_counters; ++c)
+		out << counter_names[ c] << ',';
+	out << "valid\n";
+	for ( std::size_t i = 0; i < results.size(); ++i) {
+		const Result& r = results[ i];
+		Summary s = summarize( r);
+		out << method_names[ r.method] << ','
+			<< distribution_names[ r.distribution] << ','
+			<< r.N << ',' << r.runs.size() << ','
+			<< s.median << ',' << s.p10 << ',' << s.p90 << ','
+			<< s.min << ',' << s.max << ',' << s.mean << ','
+			<< s.peak_heap << ',' << s.support_points << ','
+			<< s.passes << ',' << s.updates << ','
+			<< s.prefilter_ratio << ',';
+		for ( int c = 0; c < num_of_counters; ++c)
+			out << s.counters[ c] << ',';
+		out << ( s.valid ? "true" : "false") << '\n';
+	}
+}
+
+// s as a JSON string literal, quotes included
+static std::string
+json_string( const std::string& s)
+{
+	std::string result( 1, '"');
+	for ( std::size_t i = 0; i < s.size(); ++i) {
+		unsigned char c = s[ i];
+		if ( c == '"' || c == '\\') {
+			result += '\\';
+			result += char( c);
+		} else if ( c < 0x20) {
+			char escape[ 8];
+			std::snprintf( escape, sizeof( escape), "\\u%04x", unsigned( c));
+			result += escape;
+		} else
+			result += char( c);
+	}
+	return result + '"';
+}
+
+static void
+write_json( std::ostream& out, const std::vector< Result>& results,
+			const Settings& settings)
+{
+	out << "{\n"
+		<< "  \"seed\": " << settings.seed << ",\n"
+		<< "  \"repetitions\": " << settings.repetitions << ",\n"
+		<< "  \"validated\": " << ( settings.validate ? "true" : "false") << ",\n"
+		<< "  \"strategy\": \"" << strategy_names[ settings.strategy] << "\",\n"
+		<< "  \"shuffle\": " << ( settings.shuffle ? "true" : "false") << ",\n"
+		<< "  \"prefilter_directions\": " << settings.prefilter << ",\n"
+		<< "  \"epsilon\": " << settings.epsilon << ",\n"
+		<< "  \"gmp_pool\": " << ( settings.gmp_pool ? "true" : "false") << ",\n"
+		<< "  \"input\": " << json_string( settings.input) << ",\n"
+		<< "  \"results\": [\n";
+	for ( std::size_t i = 0; i < results.size(); ++i) {
+		const Result& r = results[ i];
+		Summary s = summarize( r);
+		out << "    {\"method\": \"" << method_names[ r.method]
+			<< "\", \"distribution\": \"" << distribution_names[ r.distribution]
+			<< "\", \"n\": " << r.N
+			<< ", \"median_ms\": " << s.median
+			<< ", \"p10_ms\": " << s.p10
+			<< ", \"p90_ms\": " << s.p90
+			<< ", \"min_ms\": " << s.min
+			<< ", \"max_ms\": " << s.max
+			<< ", \"mean_ms\": " << s.mean
+			<< ", \"peak_heap_bytes\": " << s.peak_heap
+			<< ", \"support_points\": " << s.support_points
+			<< ", \"passes\": " << s.passes
+			<< ", \"updates\": " << s.updates
+			<< ", \"prefilter_ratio\": " << s.prefilter_ratio;
+		for ( int c = 0; c < num_of_counters; ++c)
+			out << ", \"" << counter_names[ c] << "\": " << s.counters[ c];
+		out << ", \"valid\": " << ( s.valid ? "true" : "false")
+			<< ", \"times_ms\": [";
+		for ( std::size_t j = 0; j < r.runs.size(); ++j)
+			out << ( j ? ", " : "") << r.runs[ j].seconds * 1000.0;
+		out << "]}" << ( i + 1 < results.size() ? "," : "") << "\n";
+	}
+	out << "  ],\n"
+		<< "  \"peak_rss_kb\": " << peak_rss_kb() << "\n"
+		<< "}\n";
+}
+
+// Command line
+// ============
+
+static void
+usage( )
+{
+	std::cerr <<
+		"usage: min_ellipse_2 [options]\n"
+		"  --methods LIST    comma separated, default rublev,rublev_lp_solve,cgal,rublev_convex_hull\n"
+		"                    (also: rublev_parallel, rublev_streaming, rublev_batch,\n"
+		"                    rublev_hull_first, khachiyan, rublev_3, welzl_3,\n"
+		"                    rublev_view, rublev_window, rublev_divide, all)\n"
+		"                    the 3D methods rublev_3 and welzl_3 use the cube, ball,\n"
+		"                    sphere and cube surface for the four distributions\n"
+		"  --dist LIST       in_square,in_disc,on_circle,on_square or all (default all)\n"
+		"  --n SIZES         comma separated sizes and sweeps FROM:TO:FACTOR (default 1000)\n"
+		"  --reps R          repetitions per configuration (default 5)\n"
+		"  --seed S          seed of the first repetition, repetition i uses S+i (default 1)\n"
+		"  --threads T       threads of rublev_parallel, rublev_batch,\n"
+		"                    rublev_hull_first and rublev_divide, 0 for all (default 0)\n"
+		"  --cluster C       points per set of rublev_batch (default 100)\n"
+		"  --window W        points in the sliding window of rublev_window (default 1000)\n"
+		"  --strategy S      update strategy of the rublev methods: restart,\n"
+		"                    move_to_front or pivoting (default restart)\n"
+		"  --shuffle         randomly permute the points before solving (rublev methods)\n"
+		"  --epsilon E       tolerance of khachiyan and the 3D methods (default 0.001)\n"
+		"  --prefilter K     Akl-Toussaint prefilter with K directions (3 to 16) for\n"
+		"                    rublev_convex_hull and rublev_parallel, 0 for none (default 0)\n"
+		"  --gmp-pool        allocate GMP numbers from per-thread pools\n"
+		"  --validate        check every result with is_valid()\n"
+		"  --format F        csv or json (default csv)\n"
+		"  --output FILE     write results to FILE instead of stdout\n"
+		"  --input FILE      solve the points of a binary file instead of the\n"
+		"                    generated ones (2D methods only; --dist and --n are ignored)\n"
+		"  --input-format F  coordinates of FILE: f64 or i32 (default f64)\n"
+		"  --header B        bytes to skip at the start of FILE (default 0)\n"
+		"  --stride B        bytes from one point to the next, 0 for packed (default 0)\n";
+}
+
+static std::vector< std::string>
+split( const std::string& s, char separator)
+{
+	std::vector< std::string> parts;
+	std::string part;
+	std::istringstream in( s);
+	while ( std::getline( in, part, separator))
+		if ( !part.empty())
+			parts.push_back( part);
+	return parts;
+}
+
+static bool
+parse_names( const std::string& list, const char* names[], int n,
+			 std::vector< int>& ids)
+{
+	std::vector< std::string> parts = split( list, ',');
+	ids.clear();
+	for ( std::size_t i = 0; i < parts.size(); ++i) {
+		if ( parts[ i] == "all") {
+			for ( int j = 0; j < n; ++j)
+				ids.push_back( j);
+			continue;
 		}
-		
-		{
-			t = clock();
-			CGAL::Min_ellipse_2_rublev_lp_solver< Traits>  me( points.begin(), points.end());
-			t = clock() - t;
-			sum[ 1] += t;
-			sum2[ 1] += t*t;
-			if (test_validness)
-			{
-				if ( !me.is_valid( false))
-					me.is_valid( true);
-			}
+		int j = 0;
+		while ( j < n && parts[ i] != names[ j])
+			++j;
+		if ( j == n) {
+			std::cerr << "unknown name: " << parts[ i] << "\n";
+			return false;
 		}
+		ids.push_back( j);
+	}
+	return !ids.empty();
+}
 
-		{
-			t = clock();
-			CGAL::Min_ellipse_2< Traits>  me( points.begin(), points.end());
-			t = clock() - t;
-			sum[ 2] += t;
-			sum2[ 2] += t*t;
-			if (test_validness)
-			{
-				if ( !me.is_valid( false))
-					me.is_valid( true);
-			}
+static bool
+parse_sizes( const std::string& list, std::vector< int>& sizes)
+{
+	std::vector< std::string> parts = split( list, ',');
+	sizes.clear();
+	for ( std::size_t i = 0; i < parts.size(); ++i) {
+		std::vector< std::string> sweep = split( parts[ i], ':');
+		if ( sweep.size() == 1) {
+			sizes.push_back( std::atoi( sweep[ 0].c_str()));
 		}
-
-		{
-			t = clock();
-			CGAL::Min_ellipse_2_rublev< Traits>  me( points.begin(), points.end(), true);
-			t = clock() - t;
-			sum[ 3] += t;
-			sum2[ 3] += t*t;
-			if (test_validness)
-			{
-				if ( !me.is_valid( false))
-					me.is_valid( true);
-			}
+		else if ( sweep.size() == 3) {
+			double n = std::atof( sweep[ 0].c_str());
+			double to = std::atof( sweep[ 1].c_str());
+			double factor = std::atof( sweep[ 2].c_str());
+			if ( factor <= 1.0)
+				return false;
+			for ( ; n <= to * ( 1.0 + 1e-9); n *= factor)
+				sizes.push_back( int( n + 0.5));
 		}
+		else
+			return false;
+	}
+	for ( std::size_t i = 0; i < sizes.size(); ++i)
+		if ( sizes[ i] <= 0)
+			return false;
+	return !sizes.empty();
+}
 
-		if (clock() - prev_verbose_time > 3000) {
-			for (i = 0; i < num_of_methods; ++i)
-			{
-				M[ i] = ((double)sum[ i]/iterations) + 0.001;
-				M2[ i] = sqrt( ((double) sum2[ i] / iterations) - M[ i] * M[ i]);
+static bool
+parse_arguments( int argc, char** argv, Settings& settings)
+{
+	parse_names( "rublev,rublev_lp_solve,cgal,rublev_convex_hull",
+				 method_names, num_of_methods, settings.methods);
+	parse_names( "all", distribution_names, num_of_distributions,
+				 settings.distributions);
+	settings.sizes.push_back( 1000);
+
+	for ( int i = 1; i < argc; ++i) {
+		std::string arg = argv[ i];
+		bool has_value = i + 1 < argc;
+		if ( arg == "--validate")
+			settings.validate = true;
+		else if ( arg == "--shuffle")
+			settings.shuffle = true;
+		else if ( arg == "--gmp-pool")
+			settings.gmp_pool = true;
+		else if ( arg == "--help" || arg == "-h")
+			return false;
+		else if ( !has_value) {
+			std::cerr << "missing value for " << arg << "\n";
+			return false;
+		}
+		else {
+			std::string value = argv[ ++i];
+			bool ok = true;
+			if ( arg == "--methods")
+				ok = parse_names( value, method_names, num_of_methods,
+								  settings.methods);
+			else if ( arg == "--dist")
+				ok = parse_names( value, distribution_names,
+								  num_of_distributions, settings.distributions);
+			else if ( arg == "--n")
+				ok = parse_sizes( value, settings.sizes);
+			else if ( arg == "--reps")
+				ok = ( settings.repetitions = std::atoi( value.c_str())) > 0;
+			else if ( arg == "--seed")
+				settings.seed = (unsigned int) std::strtoul( value.c_str(), 0, 10);
+			else if ( arg == "--threads")
+				ok = ( settings.threads = std::atoi( value.c_str())) >= 0;
+			else if ( arg == "--cluster")
+				ok = ( settings.cluster_size = std::atoi( value.c_str())) > 0;
+			else if ( arg == "--window")
+				ok = ( settings.window = std::atoi( value.c_str())) > 0;
+			else if ( arg == "--epsilon")
+				ok = ( settings.epsilon = std::atof( value.c_str())) > 0;
+			else if ( arg == "--prefilter") {
+				settings.prefilter = std::atoi( value.c_str());
+				ok = settings.prefilter == 0 ||
+					( settings.prefilter >= 3 && settings.prefilter <= 16);
+			}
+			else if ( arg == "--strategy") {
+				if ( value == "restart")
+					settings.strategy = Rublev::RESTART_UPDATES;
+				else if ( value == "move_to_front")
+					settings.strategy = Rublev::MOVE_TO_FRONT_UPDATES;
+				else if ( value == "pivoting")
+					settings.strategy = Rublev::PIVOTING_UPDATES;
+				else
+					ok = false;
+			}
+			else if ( arg == "--format")
+				ok = value == "csv" || value == "json";
+			else if ( arg == "--output")
+				settings.output = value;
+			else if ( arg == "--input")
+				settings.input = value;
+			else if ( arg == "--input-format") {
+				if ( value == "f64")
+					settings.input_format.coordinates = Point_file::FLOAT64;
+				else if ( value == "i32")
+					settings.input_format.coordinates = Point_file::INT32;
+				else
+					ok = false;
+			}
+			else if ( arg == "--header")
+				settings.input_format.header_bytes =
+					std::size_t( std::strtoull( value.c_str(), 0, 10));
+			else if ( arg == "--stride")
+				settings.input_format.stride =
+					std::size_t( std::strtoull( value.c_str(), 0, 10));
+			else {
+				std::cerr << "unknown option: " << arg << "\n";
+				return false;
+			}
+			if ( arg == "--format")
+				settings.format = value;
+			if ( !ok) {
+				std::cerr << "invalid value for " << arg << ": " << value << "\n";
+				return false;
 			}
-				
-			std::cout << std::setprecision(6) << " " << iterations;
-				//<< " " << iterations << "\t| " << M[ 0] << "\t| " << M2[ 0] << "\t| " << M[ 1] << "\t| " << M2[ 1] << "\n";
-			for (i = 0; i < num_of_methods; ++i)
-				std::cout << std::setprecision(8) << "\t| " << M[ i];
-			std::cout << "\n";
-			std::cout.flush();
-			prev_verbose_time = clock();
 		}
 	}
-    return;
+	return true;
 }
 
 int
-main( int, char**)
+main( int argc, char** argv)
 {
-	test_mve();
-}
\ No newline at end of file
+	Settings settings;
+	std::vector< Result> results;
+	std::vector< Point> points;
+	std::vector< Point_3> points_3;
+	std::size_t m, d, s;
+	int rep;
+	bool all_valid = true;
+
+	// before the first GMP number is created
+	mp_set_memory_functions( gmp_allocate, gmp_reallocate, gmp_free);
+
+	if ( !parse_arguments( argc, argv, settings)) {
+		usage();
+		return 2;
+	}
+	if ( settings.gmp_pool)
+		CGAL::Min_ellipse_2_rublev_gmp_pool::install();
+
+	// a point file replaces the distributions and sizes by its contents,
+	// which the solvers read from the mapping
+	Point_file input;
+	if ( !settings.input.empty()) {
+		if ( std::count_if( settings.methods.begin(), settings.methods.end(),
+							is_3d_method) > 0) {
+			std::cerr << "the 3D methods cannot read --input\n";
+			return 2;
+		}
+		if ( !input.open( settings.input, settings.input_format)) {
+			std::cerr << input.error() << "\n";
+			return 2;
+		}
+		if ( input.empty()) {
+			std::cerr << "no points in " << settings.input << "\n";
+			return 2;
+		}
+		settings.distributions.assign( 1, file_distribution);
+		settings.sizes.assign( 1, int( input.size()));
+	}
+
+	for ( d = 0; d < settings.distributions.size(); ++d)
+		for ( s = 0; s < settings.sizes.size(); ++s) {
+			std::size_t first = results.size();
+			for ( m = 0; m < settings.methods.size(); ++m) {
+				Result result;
+				result.method = settings.methods[ m];
+				result.distribution = settings.distributions[ d];
+				result.N = settings.sizes[ s];
+				results.push_back( result);
+			}
+
+			// every method sees the same point sets
+			for ( rep = 0; rep < settings.repetitions; ++rep) {
+				if ( settings.distributions[ d] != file_distribution)
+					generate_points( settings.distributions[ d], settings.sizes[ s],
+									 settings.seed + rep, points);
+				if ( std::count_if( settings.methods.begin(), settings.methods.end(),
+									is_3d_method) > 0)
+					generate_points_3( settings.distributions[ d], settings.sizes[ s],
+									   settings.seed + rep, points_3);
+				for ( m = 0; m < settings.methods.size(); ++m) {
+					Run run = settings.distributions[ d] == file_distribution
+						? run_method( settings.methods[ m], input, points_3, settings)
+						: run_method( settings.methods[ m], points, points_3, settings);
+					all_valid = all_valid && run.valid;
+					results[ first + m].runs.push_back( run);
+				}
+			}
+
+			for ( m = 0; m < settings.methods.size(); ++m) {
+				const Result& r = results[ first + m];
+				Summary summary = summarize( r);
+				std::cerr << std::setw( 20) << method_names[ r.method]
+						  << std::setw( 12) << distribution_names[ r.distribution]
+						  << std::setw( 10) << r.N
+						  << std::setw( 14) << std::setprecision( 6)
+						  << summary.median << " ms"
+						  << ( summary.valid ? "" : "  INVALID") << "\n";
+			}
+		}
+
+	std::ofstream file;
+	if ( !settings.output.empty()) {
+		file.open( settings.output.c_str());
+		if ( !file) {
+			std::cerr << "cannot write " << settings.output << "\n";
+			return 2;
+		}
+	}
+	std::ostream& out = settings.output.empty() ? std::cout : file;
+	out << std::setprecision( 6);
+	if ( settings.format == "json")
+		write_json( out, results, settings);
+	else
+		write_csv( out, results);
+
+	return all_valid ? 0 : 1;
+}
@@ -1,60 +1,202 @@
-// example: function to check whether a point is in the convex 
-// hull of other points; this version uses a maker
-#include <boost/config.hpp>
-#include <boost/iterator/transform_iterator.hpp>
-#include <CGAL/Kernel_traits.h>
-#include <CGAL/QP_models.h>
-#include <CGAL/QP_functions.h>
-
-// unary function to get homogeneous begin-iterator of point
-template <class Point_d>
-struct Homogeneous_begin  {
-  typedef typename Point_d::Homogeneous_const_iterator result_type;
-  result_type operator() (const Point_d& p) const {
-    return p.homogeneous_begin();
-  }
-};
-
-// function to test whether point is in the convex hull of other points;
-// the type ET is an exact type used for the computations
-template <class Point_d, class RandomAccessIterator, class ET>
-CGAL::Quadratic_program_solution<ET>
-solve_convex_hull_containment_lp (const Point_d& p,
-				  RandomAccessIterator begin,
-				  RandomAccessIterator end, const ET& dummy)
-{
-  // construct program and solve it
-  return CGAL::solve_nonnegative_linear_program
-    (CGAL::make_nonnegative_linear_program_from_iterators
-     (end-begin,                                                           // n
-      p.dimension()+1,                                                     // m
-      boost::transform_iterator
-      <Homogeneous_begin<Point_d>, RandomAccessIterator>(begin),           // A
-      typename Point_d::Homogeneous_const_iterator (p.homogeneous_begin()),// b
-      CGAL::Const_oneset_iterator<CGAL::Comparison_result>(CGAL::EQUAL),   // ~
-      CGAL::Const_oneset_iterator
-      <typename CGAL::Kernel_traits<Point_d>::Kernel::RT> (0)), dummy);    // c
-} 
-
-// I've been puzzled with the example provided in CGAL for testing whether the point is inside the convex hull of point set.
-// The main issue was that Point_2 (in comparison with Point_d) doesn't contain an Homogeneous_const_iterator type. 
-// I tried to use something like Cartesian_const_iterator instead, but then some runtime assertion is raised. 
-// So I've came up with dumb approach simply converting all available data to what is being used in example.
-// I also have hard times every time I need to debug something. So the process is not so fast as I wish.
-template <class Point, class RandomAccessIterator, class Point_d, class ET> 
-bool is_in_convex_hull (const Point& p,
-			RandomAccessIterator begin,
-			RandomAccessIterator end,
-			const Point_d& dummy,
-			const ET& dummy2)
-{
-	Point_d point = Point_d(p.x(), p.y());
-	std::vector<Point_d> points;
-	for (std::vector<Point>::iterator it = begin; it != end; ++it)
-		points.push_back(Point_d(it->x(), it->y()));
-
-	CGAL::Quadratic_program_solution<ET> s =
-		solve_convex_hull_containment_lp (point, points.begin(), points.end(), ET(0));
-
-    return !s.is_infeasible();
-}
+// example: function to check whether a point is in the convex 
+// hull of other points; this version uses a maker
+#include <boost/config.hpp>
+#include <boost/iterator/transform_iterator.hpp>
+#include <CGAL/Kernel_traits.h>
+#include <CGAL/QP_models.h>
+#include <CGAL/QP_functions.h>
+#include <CGAL/ch_graham_andrew.h>
+#include <vector>
+#include <cmath>
+#include <limits>
+
+// unary function to get homogeneous begin-iterator of point
+template <class Point_d>
+struct Homogeneous_begin  {
+  typedef typename Point_d::Homogeneous_const_iterator result_type;
+  result_type operator() (const Point_d& p) const {
+    return p.homogeneous_begin();
+  }
+};
+
+// function to test whether point is in the convex hull of other points;
+// the type ET is an exact type used for the computations
+template <class Point_d, class RandomAccessIterator, class ET>
+CGAL::Quadratic_program_solution<ET>
+solve_convex_hull_containment_lp (const Point_d& p,
+				  RandomAccessIterator begin,
+				  RandomAccessIterator end, const ET& dummy)
+{
+  // construct program and solve it
+  return CGAL::solve_nonnegative_linear_program
+    (CGAL::make_nonnegative_linear_program_from_iterators
+     (end-begin,                                                           // n
+      p.dimension()+1,                                                     // m
+      boost::transform_iterator
+      <Homogeneous_begin<Point_d>, RandomAccessIterator>(begin),           // A
+      typename Point_d::Homogeneous_const_iterator (p.homogeneous_begin()),// b
+      CGAL::Const_oneset_iterator<CGAL::Comparison_result>(CGAL::EQUAL),   // ~
+      CGAL::Const_oneset_iterator
+      <typename CGAL::Kernel_traits<Point_d>::Kernel::RT> (0)), dummy);    // c
+} 
+
+// I've been puzzled with the example provided in CGAL for testing whether the point is inside the convex hull of point set.
+// The main issue was that Point_2 (in comparison with Point_d) doesn't contain an Homogeneous_const_iterator type. 
+// I tried to use something like Cartesian_const_iterator instead, but then some runtime assertion is raised. 
+// So I've came up with dumb approach simply converting all available data to what is being used in example.
+// I also have hard times every time I need to debug something. So the process is not so fast as I wish.
+
+// Containment engine for the LP formulation. The points are converted to
+// Point_d once per set() and reused by every query, so a query costs one
+// LP solve and no conversion of the point set. Works in any dimension.
+template <class Point_d, class ET>
+class Convex_hull_containment_lp {
+  public:
+	template <class InputIterator>
+	void set (InputIterator begin, InputIterator end)
+	{
+		points.clear();
+		for (; begin != end; ++begin)
+			points.push_back(*begin);
+	}
+
+	bool has_on_closure (const Point_d& p) const
+	{
+		if (points.empty())
+			return false;
+		CGAL::Quadratic_program_solution<ET> s =
+			solve_convex_hull_containment_lp (p, points.begin(), points.end(), ET(0));
+		return !s.is_infeasible();
+	}
+
+  private:
+	std::vector<Point_d> points;
+};
+
+// Containment engine for the plane. set() computes the convex hull of the
+// points and stores it as half-planes a*x + b*y + c >= 0 in exact arithmetic;
+// a query then evaluates at most one linear form per hull edge. Degenerate
+// hulls are described by the same half-planes: a segment by its line taken
+// with both signs plus two caps, a single point by four axis-parallel ones.
+// The half-planes are also kept rounded to double, and a query evaluates
+// them in double precision with an error bound first; only the edges the
+// bound cannot decide are evaluated exactly. Storage is reused between
+// calls, so a query allocates nothing unless it has to fall back to exact
+// arithmetic, i.e. for points on or within rounding error of an edge.
+template <class Point>
+class Convex_hull_containment_2 {
+  public:
+	typedef typename Point::R::FT FT;
+
+	Convex_hull_containment_2 () : empty(true) {}
+
+	template <class InputIterator>
+	void set (InputIterator begin, InputIterator end)
+	{
+		hull.clear();
+		a.clear(); b.clear(); c.clear();
+		ad.clear(); bd.clear(); cd.clear();
+		CGAL::ch_graham_andrew(begin, end, std::back_inserter(hull));
+		empty = hull.empty();
+
+		std::size_t n = hull.size();
+		if (n == 1) {
+			const Point& h = hull[0];
+			add(FT(1), FT(0), -h.x());
+			add(FT(-1), FT(0), h.x());
+			add(FT(0), FT(1), -h.y());
+			add(FT(0), FT(-1), h.y());
+		} else if (n == 2) {
+			const Point& p = hull[0];
+			const Point& q = hull[1];
+			add_edge(p, q);
+			add_edge(q, p);
+			FT dx = q.x() - p.x(), dy = q.y() - p.y();
+			add(dx, dy, -(dx*p.x() + dy*p.y()));
+			add(-dx, -dy, dx*q.x() + dy*q.y());
+		} else {
+			// the hull is counterclockwise, so the interior is to the left
+			for (std::size_t i = 0; i < n; ++i)
+				add_edge(hull[i], hull[(i+1) % n]);
+		}
+	}
+
+	// true iff p lies in the closed convex hull
+	bool has_on_closure (const Point& p) const
+	{
+		if (empty)
+			return false;
+		const double x = CGAL::to_double(p.x());
+		const double y = CGAL::to_double(p.y());
+		bool uncertain = false;
+		std::size_t i;
+		for (i = 0; i < ad.size(); ++i) {
+			double bound;
+			double v = evaluate(i, x, y, bound);
+			if (!(v > bound)) {
+				if (v < -bound)
+					return false;
+				uncertain = true;
+			}
+		}
+		if (!uncertain)
+			return true;
+
+		// exact test of the edges the filter could not decide
+		for (i = 0; i < ad.size(); ++i) {
+			double bound;
+			double v = evaluate(i, x, y, bound);
+			if (!(v > bound) && a[i]*p.x() + b[i]*p.y() + c[i] < FT(0))
+				return false;
+		}
+		return true;
+	}
+
+  private:
+	void add (const FT& ai, const FT& bi, const FT& ci)
+	{
+		a.push_back(ai); b.push_back(bi); c.push_back(ci);
+		ad.push_back(CGAL::to_double(ai));
+		bd.push_back(CGAL::to_double(bi));
+		cd.push_back(CGAL::to_double(ci));
+	}
+
+	// half-plane i at (x, y) in double precision; the result differs from
+	// the exact value at the point the doubles were rounded from by at most
+	// bound. 2^-48 covers the rounding of the coefficients, the coordinates
+	// and the evaluation, as in Min_ellipse_2_rublev_hull_filter; overflow
+	// gives an infinite or NaN bound, i.e. an uncertain result
+	double evaluate (std::size_t i, double x, double y, double& bound) const
+	{
+		bound = (std::fabs(ad[i]*x) + std::fabs(bd[i]*y) + std::fabs(cd[i]))
+		      * 3.5527136788005009e-15 + (std::numeric_limits<double>::min)();
+		return ad[i]*x + bd[i]*y + cd[i];
+	}
+
+	// half-plane to the left of the directed line pq
+	void add_edge (const Point& p, const Point& q)
+	{
+		add(p.y() - q.y(), q.x() - p.x(), p.x()*q.y() - p.y()*q.x());
+	}
+
+	bool empty;
+	std::vector<Point> hull;
+	std::vector<FT> a, b, c;
+	std::vector<double> ad, bd, cd;
+};
+
+template <class Point, class RandomAccessIterator, class Point_d, class ET> 
+bool is_in_convex_hull (const Point& p,
+			RandomAccessIterator begin,
+			RandomAccessIterator end,
+			const Point_d& dummy,
+			const ET& dummy2)
+{
+	std::vector<Point_d> points;
+	for (RandomAccessIterator it = begin; it != end; ++it)
+		points.push_back(Point_d(it->x(), it->y()));
+
+	Convex_hull_containment_lp<Point_d, ET> engine;
+	engine.set(points.begin(), points.end());
+	return engine.has_on_closure(Point_d(p.x(), p.y()));
+}
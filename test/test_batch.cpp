@@ -0,0 +1,149 @@
+// Checks Min_ellipse_2_rublev_batch against one Min_ellipse_2_rublev solve
+// per set: for every thread count and set of solver options, each set has
+// the same support points, its support indices refer to the flat point
+// array, and its ellipse is the one of CGAL::Min_ellipse_2. The sets
+// include empty, tiny, collinear and duplicate ones.
+
+#include <CGAL/Cartesian.h>
+#include <CGAL/Gmpq.h>
+#include <CGAL/Random.h>
+#include <CGAL/point_generators_2.h>
+#include <CGAL/Min_ellipse_2.h>
+#include <CGAL/Min_ellipse_2_traits_2.h>
+#include "Min_ellipse_2_rublev.h"
+#include "Min_ellipse_2_rublev_batch.h"
+
+#include <vector>
+#include <cstdio>
+
+typedef CGAL::Gmpq                              NT;
+typedef CGAL::Cartesian< NT>                    K;
+typedef CGAL::Point_2< K>                       Point;
+typedef CGAL::Min_ellipse_2_traits_2< K>        Traits;
+typedef CGAL::Min_ellipse_2< Traits>            Cgal_min_ellipse;
+typedef CGAL::Min_ellipse_2_rublev< Traits>     Min_ellipse;
+typedef CGAL::Min_ellipse_2_rublev_batch< Traits>  Batch;
+
+static int failures = 0;
+
+// set i of the batch against a sequential solve of the same points and
+// against the ellipse of CGAL::Min_ellipse_2
+static bool
+same_set( const Batch& batch, std::size_t i, const std::vector< Point>& points,
+          std::size_t first, const Min_ellipse& me,
+          const Cgal_min_ellipse& reference)
+{
+    int j;
+    if ( batch.number_of_support_points( i) != me.number_of_support_points())
+        return( false);
+    for ( j = 0; j < me.number_of_support_points(); ++j) {
+        std::size_t index = batch.support_point_index( i, j);
+        if ( index != first + me.support_point_index( j) ||
+             !( points[ index] == me.support_point( j)) ||
+             !batch.ellipse( i).has_on_boundary( points[ index]) ||
+             !reference.ellipse().has_on_boundary( points[ index]))
+            return( false);
+    }
+    for ( j = 0; j < reference.number_of_support_points(); ++j)
+        if ( !batch.ellipse( i).has_on_boundary( reference.support_point( j)))
+            return( false);
+    return( true);
+}
+
+static void
+check( const char* name, const std::vector< Point>& points,
+       const std::vector< std::size_t>& offsets)
+{
+    const std::size_t n_sets = offsets.size() - 1;
+    const char* modes[ 4] = { "hull heuristic", "no heuristic", "move to front",
+                              "parallel streaming" };
+    const int threads[ 3] = { 1, 3, 0 };
+    std::vector< Cgal_min_ellipse*> references( n_sets);
+    std::size_t i;
+
+    for ( i = 0; i < n_sets; ++i)
+        references[ i] = new Cgal_min_ellipse( points.begin() + offsets[ i],
+                                               points.begin() + offsets[ i+1]);
+
+    for ( int mode = 0; mode < 4; ++mode) {
+        Min_ellipse::Options options;
+        options.use_convex_hull_heuristic = mode != 1;
+        if ( mode == 2)
+            options.update_strategy = Min_ellipse::MOVE_TO_FRONT_UPDATES;
+        if ( mode == 3) {
+            options.parallel = true;
+            options.streaming = true;
+        }
+
+        // the batch solves every set sequentially, with restart updates
+        Min_ellipse::Options sequential = options;
+        sequential.parallel = false;
+        sequential.streaming = false;
+        sequential.update_strategy = Min_ellipse::RESTART_UPDATES;
+
+        std::vector< Min_ellipse*> solves( n_sets);
+        for ( i = 0; i < n_sets; ++i)
+            solves[ i] = new Min_ellipse( points.begin() + offsets[ i],
+                                          points.begin() + offsets[ i+1], sequential);
+
+        for ( int t = 0; t < 3; ++t) {
+            Batch batch( points.begin(), offsets.begin(), offsets.end(),
+                         options, threads[ t]);
+            if ( batch.number_of_sets() != n_sets) {
+                ++failures;
+                std::printf( "%s, %s: %d sets instead of %d\n", name, modes[ mode],
+                             (int)batch.number_of_sets(), (int)n_sets);
+                continue;
+            }
+            for ( i = 0; i < n_sets; ++i)
+                if ( !same_set( batch, i, points, offsets[ i], *solves[ i],
+                                *references[ i])) {
+                    ++failures;
+                    std::printf( "%s, %s, %d threads: set %d differs\n",
+                                 name, modes[ mode], threads[ t], (int)i);
+                }
+        }
+        for ( i = 0; i < n_sets; ++i)
+            delete solves[ i];
+    }
+
+    for ( i = 0; i < n_sets; ++i)
+        delete references[ i];
+}
+
+int
+main( )
+{
+    CGAL::Random random( 11);
+    CGAL::Random_points_in_disc_2< Point> in_disc( 100.0, random);
+    CGAL::Random_points_on_circle_2< Point> on_circle( 100.0, random);
+    std::vector< Point> points;
+    std::vector< std::size_t> offsets( 1, 0);
+
+    // sets of random sizes, the sizes up to five exercising the small cases
+    for ( int s = 0; s < 60; ++s) {
+        int n = s < 12 ? s % 6 : random.get_int( 6, 120);
+        for ( int k = 0; k < n; ++k, ++in_disc, ++on_circle)
+            points.push_back( s % 2 == 0 ? *in_disc : *on_circle);
+        offsets.push_back( points.size());
+    }
+
+    // collinear points, duplicates and a small integer grid
+    for ( int k = 0; k < 50; ++k)
+        points.push_back( Point( k, 2*k + 1));
+    offsets.push_back( points.size());
+    for ( int k = 0; k < 20; ++k)
+        points.push_back( Point( 3, 4));
+    offsets.push_back( points.size());
+    for ( int k = 0; k < 300; ++k)
+        points.push_back( Point( random.get_int( 0, 6), random.get_int( 0, 4)));
+    offsets.push_back( points.size());
+
+    check( "sets", points, offsets);
+
+    if ( failures != 0)
+        std::printf( "%d failures\n", failures);
+    return( failures == 0 ? 0 : 1);
+}
+
+// ===== EOF =================================================================
@@ -0,0 +1,127 @@
+// Checks the divide and conquer mode of Min_ellipse_2_rublev against the
+// sequential solver and CGAL::Min_ellipse_2: on one and four threads,
+// with the parallel passes, without the convex hull heuristic and over a
+// view of the points, with and without its own order, the result is
+// valid, has the ellipse of both, and support_point( i) is the point at
+// support_point_index( i) in [ points_begin(), points_end()). On random
+// points the chunks' support points leave only a few updates.
+
+#include <CGAL/Cartesian.h>
+#include <CGAL/Gmpq.h>
+#include <CGAL/Random.h>
+#include <CGAL/point_generators_2.h>
+#include <CGAL/Min_ellipse_2.h>
+#include <CGAL/Min_ellipse_2_traits_2.h>
+#include "Min_ellipse_2_rublev.h"
+
+#include <vector>
+#include <cstdio>
+
+typedef CGAL::Gmpq                              NT;
+typedef CGAL::Cartesian< NT>                    K;
+typedef CGAL::Point_2< K>                       Point;
+typedef CGAL::Min_ellipse_2_traits_2< K>        Traits;
+typedef CGAL::Min_ellipse_2< Traits>            Cgal_min_ellipse;
+typedef CGAL::Min_ellipse_2_rublev< Traits>     Min_ellipse;
+
+static int failures = 0;
+
+// the support points of me are on the boundary of both reference
+// ellipses and vice versa, and refer to [ points_begin(), points_end())
+static bool
+same_ellipse( const Min_ellipse& me, const Min_ellipse& sequential,
+              const Cgal_min_ellipse& reference)
+{
+    int j;
+    if ( me.number_of_support_points() != sequential.number_of_support_points())
+        return( false);
+    for ( j = 0; j < sequential.number_of_support_points(); ++j)
+        if ( !me.ellipse().has_on_boundary( sequential.support_point( j)))
+            return( false);
+    for ( j = 0; j < reference.number_of_support_points(); ++j)
+        if ( !me.ellipse().has_on_boundary( reference.support_point( j)))
+            return( false);
+    for ( j = 0; j < me.number_of_support_points(); ++j)
+        if ( !sequential.ellipse().has_on_boundary( me.support_point( j)) ||
+             !reference.ellipse().has_on_boundary( me.support_point( j)) ||
+             !( me.support_point( j) == *( me.points_begin() + me.support_point_index( j))))
+            return( false);
+    return( true);
+}
+
+static void
+check( const char* name, const std::vector< Point>& points, int max_updates)
+{
+    const int n_modes = 6;
+    const char* modes[ n_modes] = {
+        "four threads", "one thread", "parallel", "no heuristic", "view",
+        "permuted view" };
+    Cgal_min_ellipse reference( points.begin(), points.end());
+    Min_ellipse sequential( points.begin(), points.end(), Min_ellipse::Options());
+    const Point* first = &points[ 0];
+    const Point* last = first + points.size();
+
+    for ( int mode = 0; mode < n_modes; ++mode) {
+        Min_ellipse::Options options;
+        options.divide_and_conquer = true;
+        options.n_threads = mode == 1 ? 1 : 4;
+        options.parallel = mode == 2;
+        options.use_convex_hull_heuristic = mode != 3;
+        options.random_permutation = mode == 5;
+
+        Min_ellipse me( options);
+        if ( mode >= 4)
+            me.assign_view( first, last);
+        else
+            me.assign( points.begin(), points.end());
+        if ( !me.is_valid() || !same_ellipse( me, sequential, reference)) {
+            ++failures;
+            std::printf( "%s, %s: not the ellipse of the sequential solver\n",
+                         name, modes[ mode]);
+        }
+        if ( mode != 1 && int( me.number_of_updates()) > max_updates) {
+            ++failures;
+            std::printf( "%s, %s: %d updates after seeding from the chunks\n",
+                         name, modes[ mode], int( me.number_of_updates()));
+        }
+    }
+}
+
+template < class Generator >
+static void
+check_random( const char* name, int n, CGAL::Random& random)
+{
+    Generator generator( 100.0, random);
+    std::vector< Point> points;
+    for ( int i = 0; i < n; ++i, ++generator)
+        points.push_back( *generator);
+    check( name, points, 5);
+}
+
+int
+main( )
+{
+    CGAL::Random random( 23);
+
+    // four chunks take at least 4096 points
+    check_random< CGAL::Random_points_in_square_2< Point> >( "in square", 5000, random);
+    check_random< CGAL::Random_points_in_disc_2< Point> >( "in disc", 5000, random);
+    check_random< CGAL::Random_points_on_circle_2< Point> >( "on circle", 5000, random);
+    check_random< CGAL::Random_points_on_square_2< Point> >( "on square", 5000, random);
+
+    // a small integer grid: duplicates and many cocircular points
+    std::vector< Point> grid;
+    for ( int i = 0; i < 5000; ++i)
+        grid.push_back( Point( random.get_int( 0, 12), random.get_int( 0, 9)));
+    check( "grid", grid, 1000);
+
+    // too few points to divide
+    grid.resize( 100);
+    check( "small", grid, 1000);
+
+    if ( failures != 0)
+        std::printf( "%d failures\n", failures);
+    return( failures == 0 ? 0 : 1);
+}
+
+// ===== EOF =================================================================
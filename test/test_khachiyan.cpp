@@ -0,0 +1,126 @@
+// Checks Min_ellipse_2_khachiyan: every point inside the ellipse, an area
+// between the minimum and ( 1+eps)^2 times it, with the minimum taken from
+// a solve for a much smaller eps, and the support point indices; for
+// random sets, collinear and nearly collinear points. degenerate is 1 if
+// the result must be a segment, 0 if not, -1 if either is fine.
+
+#include <CGAL/Cartesian.h>
+#include <CGAL/Gmpq.h>
+#include <CGAL/Random.h>
+#include <CGAL/point_generators_2.h>
+#include <CGAL/Min_ellipse_2_traits_2.h>
+#include "Min_ellipse_2_khachiyan.h"
+
+#include <vector>
+#include <cmath>
+#include <cstdio>
+
+typedef CGAL::Gmpq                              NT;
+typedef CGAL::Cartesian< NT>                    K;
+typedef CGAL::Point_2< K>                       Point;
+typedef CGAL::Min_ellipse_2_traits_2< K>        Traits;
+typedef CGAL::Min_ellipse_2_khachiyan< Traits>  Min_ellipse;
+
+static int failures = 0;
+
+static void
+check( const char* name, const std::vector< Point>& points, int degenerate)
+{
+    const double reference_eps = 1e-7;
+    Min_ellipse reference( points.begin(), points.end(), reference_eps);
+    const double min_area = reference.ellipse().area() / ( ( 1 + reference_eps) * ( 1 + reference_eps));
+    const double epsilon[ 3] = { 1e-1, 1e-2, 1e-3 };
+    std::size_t i;
+
+    for ( int k = 0; k < 3; ++k) {
+        const double eps = epsilon[ k];
+        Min_ellipse me( points.begin(), points.end(), eps);
+        for ( i = 0; i < points.size(); ++i)
+            if ( me.ellipse().has_on_unbounded_side( points[ i])) {
+                ++failures;
+                std::printf( "%s, eps %g: point %lu outside\n", name, eps, (unsigned long)i);
+                break;
+            }
+        double area = me.ellipse().area();
+        if ( ( degenerate >= 0 && me.ellipse().is_degenerate() != ( degenerate == 1)) ||
+             !me.is_converged() ||
+             area < min_area * ( 1 - 1e-9) ||
+             area > ( 1 + eps) * ( 1 + eps) * min_area * ( 1 + 1e-9)) {
+            ++failures;
+            std::printf( "%s, eps %g: area %g, minimum %g, degenerate %d, converged %d\n",
+                         name, eps, area, min_area, int( me.ellipse().is_degenerate()),
+                         int( me.is_converged()));
+        }
+        for ( int j = 0; j < me.number_of_support_points(); ++j)
+            if ( !( me.support_point( j) == points[ me.support_point_index( j)])) {
+                ++failures;
+                std::printf( "%s, eps %g: support point %d differs from its index\n",
+                             name, eps, j);
+            }
+    }
+}
+
+template < class Generator >
+static void
+check_random( const char* name, int n, CGAL::Random& random)
+{
+    Generator generator( 100.0, random);
+    std::vector< Point> points;
+    for ( int i = 0; i < n; ++i, ++generator)
+        points.push_back( *generator);
+    check( name, points, 0);
+}
+
+int
+main( )
+{
+    CGAL::Random random( 11);
+    std::vector< Point> points;
+    int i, trial;
+
+    for ( trial = 0; trial < 5; ++trial) {
+        check_random< CGAL::Random_points_in_square_2< Point> >( "in square", 2000, random);
+        check_random< CGAL::Random_points_in_disc_2< Point> >( "in disc", 2000, random);
+        check_random< CGAL::Random_points_on_circle_2< Point> >( "on circle", 2000, random);
+        check_random< CGAL::Random_points_on_square_2< Point> >( "on square", 2000, random);
+    }
+
+    points.clear();
+    points.push_back( Point( 0, 0));
+    points.push_back( Point( 1, 0));
+    points.push_back( Point( 0, 1));
+    check( "triangle", points, 0);
+
+    points.clear();
+    for ( i = 0; i < 50; ++i)
+        points.push_back( Point( i, 2 * i + 1));
+    check( "line", points, 1);
+
+    points.assign( 5, Point( 3, 4));
+    check( "equal points", points, 1);
+
+    // 50 points on y = 0 and one off the line by 10^-k: far enough for
+    // an ellipse, too close for the scatter matrix, or within rounding
+    const int exponent[ 5] = { 8, 100, 160, 300, 320 };
+    for ( trial = 0; trial < 5; ++trial) {
+        points.clear();
+        for ( i = 0; i < 50; ++i)
+            points.push_back( Point( i, 0));
+        points.push_back( Point( 10, std::pow( 10.0, -exponent[ trial])));
+        char name[ 32];
+        std::snprintf( name, sizeof( name), "line + 1e-%d", exponent[ trial]);
+        check( name, points, exponent[ trial] == 8 ? 0 : ( exponent[ trial] > 100 ? 1 : -1));
+    }
+
+    // a vertical line with points off it on both sides
+    points.clear();
+    for ( i = 0; i < 50; ++i)
+        points.push_back( Point( 1e-200 * ( i % 3 - 1), i));
+    check( "vertical line", points, -1);
+
+    if ( failures != 0)
+        std::printf( "%d failures\n", failures);
+    return( failures == 0 ? 0 : 1);
+}
+
+// ===== EOF =================================================================
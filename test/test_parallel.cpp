@@ -0,0 +1,124 @@
+// Checks that the parallel passes of Min_ellipse_2_rublev do not depend on
+// the number of threads: every thread count gives the same support points
+// with the same indices, the same number of passes and updates, and the
+// ellipse of CGAL::Min_ellipse_2. With and without the convex hull
+// heuristic, with the prefilter and in hull first mode.
+
+#include <CGAL/Cartesian.h>
+#include <CGAL/Gmpq.h>
+#include <CGAL/Random.h>
+#include <CGAL/point_generators_2.h>
+#include <CGAL/Min_ellipse_2.h>
+#include <CGAL/Min_ellipse_2_traits_2.h>
+#include "Min_ellipse_2_rublev.h"
+
+#include <vector>
+#include <cstdio>
+
+typedef CGAL::Gmpq                              NT;
+typedef CGAL::Cartesian< NT>                    K;
+typedef CGAL::Point_2< K>                       Point;
+typedef CGAL::Min_ellipse_2_traits_2< K>        Traits;
+typedef CGAL::Min_ellipse_2< Traits>            Cgal_min_ellipse;
+typedef CGAL::Min_ellipse_2_rublev< Traits>     Min_ellipse;
+
+static int failures = 0;
+
+// the support points of either ellipse are on the boundary of the other,
+// and the support point indices refer to [ points_begin(), points_end())
+static bool
+same_ellipse( const Min_ellipse& me, const Cgal_min_ellipse& reference)
+{
+    int j;
+    for ( j = 0; j < reference.number_of_support_points(); ++j)
+        if ( !me.ellipse().has_on_boundary( reference.support_point( j)))
+            return( false);
+    for ( j = 0; j < me.number_of_support_points(); ++j)
+        if ( !reference.ellipse().has_on_boundary( me.support_point( j)) ||
+             !( me.support_point( j) == *( me.points_begin() + me.support_point_index( j))))
+            return( false);
+    return( true);
+}
+
+static bool
+same_result( const Min_ellipse& a, const Min_ellipse& b)
+{
+    if ( a.number_of_support_points() != b.number_of_support_points() ||
+         a.number_of_passes() != b.number_of_passes() ||
+         a.number_of_updates() != b.number_of_updates())
+        return( false);
+    for ( int j = 0; j < a.number_of_support_points(); ++j)
+        if ( !( a.support_point( j) == b.support_point( j)) ||
+             a.support_point_index( j) != b.support_point_index( j))
+            return( false);
+    return( true);
+}
+
+static void
+check( const char* name, const std::vector< Point>& points)
+{
+    Cgal_min_ellipse reference( points.begin(), points.end());
+    const char* modes[ 4] = { "hull heuristic", "no heuristic", "prefilter", "hull first" };
+    const int threads[ 4] = { 1, 2, 3, 8 };
+
+    for ( int mode = 0; mode < 4; ++mode) {
+        Min_ellipse::Options options;
+        options.parallel = true;
+        options.use_convex_hull_heuristic = mode != 1;
+        options.prefilter_directions = mode == 2 ? 8 : 0;
+        options.hull_first = mode == 3;
+
+        options.n_threads = threads[ 0];
+        Min_ellipse first( points.begin(), points.end(), options);
+        if ( !same_ellipse( first, reference)) {
+            ++failures;
+            std::printf( "%s, %s: not the ellipse of CGAL::Min_ellipse_2\n",
+                         name, modes[ mode]);
+        }
+        for ( int t = 1; t < 4; ++t) {
+            options.n_threads = threads[ t];
+            Min_ellipse me( points.begin(), points.end(), options);
+            if ( !same_result( me, first)) {
+                ++failures;
+                std::printf( "%s, %s: %d threads differ from one\n",
+                             name, modes[ mode], threads[ t]);
+            }
+        }
+    }
+}
+
+template < class Generator >
+static void
+check_random( const char* name, int n, CGAL::Random& random)
+{
+    Generator generator( 100.0, random);
+    std::vector< Point> points;
+    for ( int i = 0; i < n; ++i, ++generator)
+        points.push_back( *generator);
+    check( name, points);
+}
+
+int
+main( )
+{
+    CGAL::Random random( 7);
+
+    for ( int trial = 0; trial < 2; ++trial) {
+        check_random< CGAL::Random_points_in_square_2< Point> >( "in square", 2000, random);
+        check_random< CGAL::Random_points_in_disc_2< Point> >( "in disc", 2000, random);
+        check_random< CGAL::Random_points_on_circle_2< Point> >( "on circle", 2000, random);
+        check_random< CGAL::Random_points_on_square_2< Point> >( "on square", 2000, random);
+    }
+
+    // a small integer grid: duplicates and many cocircular points
+    std::vector< Point> grid;
+    for ( int i = 0; i < 2000; ++i)
+        grid.push_back( Point( random.get_int( 0, 12), random.get_int( 0, 9)));
+    check( "grid", grid);
+
+    if ( failures != 0)
+        std::printf( "%d failures\n", failures);
+    return( failures == 0 ? 0 : 1);
+}
+
+// ===== EOF =================================================================
@@ -0,0 +1,206 @@
+// Checks Min_ellipse_2_rublev_predicate, filter and exact evaluation,
+// against Traits::Ellipse::bounded_side() for four and five support
+// points: random convex sets, integer-snapped sets, points exactly on the
+// boundary and the support points themselves.
+
+#include <CGAL/Cartesian.h>
+#include <CGAL/Gmpq.h>
+#include <CGAL/Random.h>
+#include <CGAL/Min_ellipse_2_traits_2.h>
+#include "Min_ellipse_2_rublev_predicate.h"
+
+#include <vector>
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+
+typedef CGAL::Gmpq                              NT;
+typedef CGAL::Cartesian< NT>                    K;
+typedef CGAL::Point_2< K>                       Point;
+typedef CGAL::Min_ellipse_2_traits_2< K>        Traits;
+typedef Traits::Ellipse                         Ellipse;
+typedef CGAL::Min_ellipse_2_rublev_predicate< Traits>  Predicate;
+
+static NT  tiny;
+static int failures = 0;
+static long n_tests = 0, n_filtered = 0, n_boundary = 0;
+
+static bool
+is_convex( const Point* p, int n)
+{
+    for ( int i = 0; i < n; ++i)
+        if ( CGAL::orientation( p[ i], p[ ( i+1) % n], p[ ( i+2) % n]) != CGAL::COUNTERCLOCKWISE)
+            return( false);
+    return( true);
+}
+
+static void
+set_ellipse( Ellipse& e, const Point* p, int n)
+{
+    if ( n == 4)
+        e.set( p[ 0], p[ 1], p[ 2], p[ 3]);
+    else
+        e.set( p[ 0], p[ 1], p[ 2], p[ 3], p[ 4]);
+}
+
+// compares the predicate with the ellipse through the support points
+// (given in convex position, passed on in a scrambled order) for the
+// support points, the given boundary points, their neighbours at
+// distance tiny, which only the exact evaluation decides, and random
+// points
+static void
+check( const char* name, const Point* convex, int n,
+       const std::vector< Point>& boundary, CGAL::Random& random, bool snap)
+{
+    Point support[ 5];
+    int i;
+
+    const int order[ 2][ 5] = { { 0, 2, 1, 3, 0}, { 0, 2, 4, 1, 3} };
+    for ( i = 0; i < n; ++i)
+        support[ i] = convex[ order[ n - 4][ i]];
+
+    Ellipse ellipse;
+    set_ellipse( ellipse, support, n);
+    Predicate predicate;
+    predicate.set( support, n);
+    if ( !predicate.is_set()) {
+        ++failures;
+        std::printf( "%s: predicate not set\n", name);
+        return;
+    }
+
+    std::vector< Point> queries( support, support + n);
+    queries.insert( queries.end(), boundary.begin(), boundary.end());
+    const std::size_t n_on_boundary = queries.size();
+    for ( std::size_t b = 0; b < n_on_boundary; ++b) {
+        const Point q = queries[ b];
+        queries.push_back( Point( q.x() + tiny, q.y()));
+        queries.push_back( Point( q.x() - tiny, q.y()));
+        queries.push_back( Point( q.x(), q.y() + tiny));
+        queries.push_back( Point( q.x(), q.y() - tiny));
+    }
+    double min_x = CGAL::to_double( convex[ 0].x()), max_x = min_x;
+    double min_y = CGAL::to_double( convex[ 0].y()), max_y = min_y;
+    for ( i = 1; i < n; ++i) {
+        min_x = (std::min)( min_x, CGAL::to_double( convex[ i].x()));
+        max_x = (std::max)( max_x, CGAL::to_double( convex[ i].x()));
+        min_y = (std::min)( min_y, CGAL::to_double( convex[ i].y()));
+        max_y = (std::max)( max_y, CGAL::to_double( convex[ i].y()));
+    }
+    double dx = max_x - min_x, dy = max_y - min_y;
+    for ( i = 0; i < 200; ++i) {
+        double x = random.get_double( min_x - dx, max_x + dx);
+        double y = random.get_double( min_y - dy, max_y + dy);
+        if ( snap)
+            queries.push_back( Point( std::floor( x), std::floor( y)));
+        else
+            queries.push_back( Point( NT( x) / NT( 3), NT( y) / NT( 7)));
+    }
+
+    for ( std::size_t q = 0; q < queries.size(); ++q) {
+        const Point& p = queries[ q];
+        CGAL::Bounded_side expected = ellipse.bounded_side( p);
+        CGAL::Bounded_side exact = predicate.bounded_side( p);
+        int side = predicate.side( CGAL::to_double( p.x()), CGAL::to_double( p.y()));
+        bool must_be_boundary = q < n_on_boundary;
+        ++n_tests;
+        n_filtered += side != 0;
+        n_boundary += expected == CGAL::ON_BOUNDARY;
+        if ( exact != expected ||
+             ( side != 0 && side != ( expected == CGAL::ON_UNBOUNDED_SIDE ? 1 : -1)) ||
+             ( must_be_boundary && expected != CGAL::ON_BOUNDARY)) {
+            ++failures;
+            std::printf( "%s: point %lu: predicate %d, filter %d, ellipse %d\n", name,
+                         (unsigned long)q, int( exact), side, int( expected));
+        }
+    }
+}
+
+// n points in convex position near a random ellipse
+static bool
+random_convex( CGAL::Random& random, int n, bool snap, Point* p)
+{
+    double cx = random.get_double( -50, 50), cy = random.get_double( -50, 50);
+    double a = random.get_double( 2, 30), b = random.get_double( 2, 30);
+    double rotation = random.get_double( 0, 3.14159), angle[ 5];
+    int i;
+
+    for ( i = 0; i < n; ++i)
+        angle[ i] = random.get_double( 0, 6.28318);
+    std::sort( angle, angle + n);
+    for ( i = 0; i < n; ++i) {
+        double ex = a * std::cos( angle[ i]), ey = b * std::sin( angle[ i]);
+        double x = cx + std::cos( rotation) * ex - std::sin( rotation) * ey;
+        double y = cy + std::sin( rotation) * ex + std::cos( rotation) * ey;
+        if ( snap) {
+            x = std::floor( x);
+            y = std::floor( y);
+        }
+        p[ i] = Point( x, y);
+    }
+    return( is_convex( p, n));
+}
+
+int
+main( )
+{
+    CGAL::Random random( 5);
+    tiny = NT( 1);
+    for ( int k = 0; k < 12; ++k)
+        tiny /= NT( 1000);
+    std::vector< Point> boundary;
+    Point p[ 5];
+    int trial, i;
+
+    // random and integer-snapped convex sets
+    for ( trial = 0; trial < 400; ++trial) {
+        int n = 4 + trial % 2;
+        bool snap = ( trial / 2) % 2 == 1;
+        if ( random_convex( random, n, snap, p))
+            check( snap ? "snapped" : "random", p, n, boundary, random, snap);
+    }
+
+    // five of the integer points on the circle of radius 5; the others
+    // are on the boundary too
+    const int circle[ 12][ 2] = { { 5, 0}, { 4, 3}, { 3, 4}, { 0, 5}, { -3, 4}, { -4, 3},
+                                  { -5, 0}, { -4, -3}, { -3, -4}, { 0, -5}, { 3, -4}, { 4, -3} };
+    const int chosen[ 3][ 5] = { { 0, 2, 4, 7, 10}, { 1, 3, 6, 8, 11}, { 0, 1, 2, 3, 9} };
+    for ( trial = 0; trial < 3; ++trial) {
+        boundary.clear();
+        for ( i = 0; i < 5; ++i)
+            p[ i] = Point( circle[ chosen[ trial][ i]][ 0], circle[ chosen[ trial][ i]][ 1]);
+        for ( i = 0; i < 12; ++i)
+            boundary.push_back( Point( circle[ i][ 0], circle[ i][ 1]));
+        check( "circle", p, 5, boundary, random, true);
+    }
+
+    // the rectangle ( +-3, +-4); its smallest ellipse x^2/18 + y^2/32 = 1
+    // passes through ( 3 q, 4 r) for q^2 + r^2 = 2, e.g. q, r = 7/5, 1/5.
+    // The sides are axis-parallel, which gives line pairs without x^2 term
+    boundary.clear();
+    const int rational[ 3][ 3] = { { 7, 1, 5}, { 1, 7, 5}, { 17, 7, 13} };
+    for ( i = 0; i < 12; ++i) {
+        NT q( rational[ i % 3][ 0]), r( rational[ i % 3][ 1]), d( rational[ i % 3][ 2]);
+        NT sx( ( i / 3) % 2 == 0 ? 1 : -1), sy( i / 6 == 0 ? 1 : -1);
+        boundary.push_back( Point( sx * NT( 3) * q / d, sy * NT( 4) * r / d));
+    }
+    p[ 0] = Point( 3, 4);
+    p[ 1] = Point( -3, 4);
+    p[ 2] = Point( -3, -4);
+    p[ 3] = Point( 3, -4);
+    check( "rectangle", p, 4, boundary, random, true);
+
+    // five points with tiny, non double coordinates
+    boundary.clear();
+    for ( i = 0; i < 5; ++i)
+        p[ i] = Point( NT( circle[ 2 * i][ 0]) + tiny, NT( circle[ 2 * i][ 1]));
+    check( "shifted circle", p, 5, boundary, random, false);
+
+    std::printf( "%ld tests, %ld decided by the filter, %ld on the boundary\n",
+                 n_tests, n_filtered, n_boundary);
+    if ( failures != 0)
+        std::printf( "%d failures\n", failures);
+    return( failures == 0 ? 0 : 1);
+}
+
+// ===== EOF =================================================================
@@ -0,0 +1,139 @@
+// Checks the bitmasks of Min_ellipse_2_rublev_query against the exact
+// single point test, for both bulk overloads: points which are not
+// representable as doubles, points on the boundary and random points.
+
+#include <CGAL/Cartesian.h>
+#include <CGAL/Gmpq.h>
+#include <CGAL/Random.h>
+#include <CGAL/Min_ellipse_2_traits_2.h>
+#include "Min_ellipse_2_rublev.h"
+#include "Min_ellipse_2_rublev_query.h"
+
+#include <vector>
+#include <cstdio>
+
+typedef CGAL::Gmpq                              NT;
+typedef CGAL::Cartesian< NT>                    K;
+typedef CGAL::Point_2< K>                       Point;
+typedef CGAL::Min_ellipse_2_traits_2< K>        Traits;
+typedef CGAL::Min_ellipse_2_rublev< Traits>     Min_ellipse;
+typedef CGAL::Min_ellipse_2_rublev_query< Traits>  Query;
+typedef Query::Word                             Word;
+
+static int failures = 0;
+
+static bool
+bit( const std::vector< Word>& bits, std::size_t i)
+{
+    return( ( ( bits[ i / 64] >> ( i % 64)) & 1) != 0);
+}
+
+// compares both bulk overloads and the single point test with the exact
+// ellipse; the double overload only gets the points exact as doubles
+static void
+check( const char* name, const std::vector< Point>& support,
+       const std::vector< Point>& queries)
+{
+    Min_ellipse me( support.begin(), support.end(), Min_ellipse::Options());
+    Query query( me);
+    const std::size_t n = queries.size();
+    std::vector< Word> bits( Query::number_of_words( n));
+    std::vector< double> x, y;
+    std::vector< std::size_t> ids;
+    std::size_t i, n_outside = 0, count;
+
+    for ( i = 0; i < n; ++i) {
+        double dx = CGAL::to_double( queries[ i].x());
+        double dy = CGAL::to_double( queries[ i].y());
+        if ( Point( dx, dy) == queries[ i]) {
+            x.push_back( dx);
+            y.push_back( dy);
+            ids.push_back( i);
+        }
+    }
+
+    count = query.has_on_unbounded_side( queries.begin(), queries.end(), &bits[ 0]);
+    for ( i = 0; i < n; ++i) {
+        bool exact = me.ellipse().has_on_unbounded_side( queries[ i]);
+        n_outside += exact;
+        if ( bit( bits, i) != exact || query.has_on_unbounded_side( queries[ i]) != exact) {
+            ++failures;
+            std::printf( "%s: point %lu: bulk %d, single %d, exact %d\n", name,
+                         (unsigned long)i, int( bit( bits, i)),
+                         int( query.has_on_unbounded_side( queries[ i])), int( exact));
+        }
+    }
+    if ( count != n_outside) {
+        ++failures;
+        std::printf( "%s: %lu points outside, counted %lu\n", name,
+                     (unsigned long)n_outside, (unsigned long)count);
+    }
+
+    std::vector< Word> double_bits( Query::number_of_words( x.size()) + 1);
+    query.has_on_unbounded_side( x.empty() ? 0 : &x[ 0], y.empty() ? 0 : &y[ 0],
+                                 x.size(), &double_bits[ 0]);
+    for ( i = 0; i < x.size(); ++i)
+        if ( bit( double_bits, i) != bit( bits, ids[ i])) {
+            ++failures;
+            std::printf( "%s: double point %lu differs\n", name, (unsigned long)ids[ i]);
+        }
+    std::printf( "%s: %lu points, %lu outside, %lu as doubles\n", name,
+                 (unsigned long)n, (unsigned long)n_outside, (unsigned long)x.size());
+}
+
+int
+main( )
+{
+    CGAL::Random random( 17);
+    NT tiny( 1);
+    for ( int i = 0; i < 12; ++i)
+        tiny /= NT( 1000);
+    std::vector< Point> support, queries;
+    int i;
+
+    // the circle of radius 5 through integer points: the integer points
+    // are on the boundary, their neighbours at 1e-36 are not doubles
+    const int circle[ 12][ 2] = { { 3, 4}, { 4, 3}, { 5, 0}, { 4, -3}, { 3, -4}, { 0, -5},
+                                  { -3, -4}, { -4, -3}, { -5, 0}, { -4, 3}, { -3, 4}, { 0, 5} };
+    for ( i = 0; i < 12; ++i) {
+        Point p( circle[ i][ 0], circle[ i][ 1]);
+        support.push_back( p);
+        queries.push_back( p);
+        queries.push_back( Point( p.x(), p.y() + tiny));
+        queries.push_back( Point( p.x(), p.y() - tiny));
+        queries.push_back( Point( p.x() + tiny, p.y()));
+        queries.push_back( Point( p.x() - tiny, p.y()));
+    }
+    for ( i = 0; i < 2000; ++i)
+        queries.push_back( Point( NT( random.get_int( -600, 600)) / NT( 100),
+                                  NT( random.get_int( -600, 600)) / NT( 100)));
+    for ( i = 0; i < 1000; ++i)
+        queries.push_back( Point( random.get_double( -6, 6), random.get_double( -6, 6)));
+    check( "circle", support, queries);
+
+    // four support points: the corners of a rectangle
+    support.clear();
+    queries.clear();
+    const int corners[ 4][ 2] = { { 0, 0}, { 4, 0}, { 4, 3}, { 0, 3} };
+    for ( i = 0; i < 4; ++i) {
+        Point p( corners[ i][ 0], corners[ i][ 1]);
+        support.push_back( p);
+        queries.push_back( p);
+        queries.push_back( Point( p.x() + tiny, p.y() + tiny));
+        queries.push_back( Point( p.x() - tiny, p.y() - tiny));
+        queries.push_back( Point( p.x() + tiny, p.y() - tiny));
+    }
+    support.push_back( Point( 2, 1));
+    for ( i = 0; i < 2000; ++i)
+        queries.push_back( Point( NT( random.get_int( -300, 700)) / NT( 3),
+                                  NT( random.get_int( -300, 700)) / NT( 7)));
+    for ( i = 0; i < 1000; ++i)
+        queries.push_back( Point( random.get_double( -2, 6), random.get_double( -2, 5)));
+    check( "rectangle", support, queries);
+
+    if ( failures != 0)
+        std::printf( "%d failures\n", failures);
+    return( failures == 0 ? 0 : 1);
+}
+
+// ===== EOF =================================================================
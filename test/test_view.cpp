@@ -0,0 +1,167 @@
+// Checks the view mode of Min_ellipse_2_rublev against the copying
+// constructor: the View_tag constructor and assign_view() give the same
+// support points with the same indices, the same point order and the same
+// number of passes and updates, for every set of solver options, and
+// leave the caller's points unmodified. support_point( i) is the point
+// at support_point_index( i) in [ points_begin(), points_end()), and the
+// ellipse is the one of CGAL::Min_ellipse_2. insert() ends the view.
+
+#include <CGAL/Cartesian.h>
+#include <CGAL/Gmpq.h>
+#include <CGAL/Random.h>
+#include <CGAL/point_generators_2.h>
+#include <CGAL/Min_ellipse_2.h>
+#include <CGAL/Min_ellipse_2_traits_2.h>
+#include "Min_ellipse_2_rublev.h"
+
+#include <algorithm>
+#include <vector>
+#include <cstdio>
+
+typedef CGAL::Gmpq                              NT;
+typedef CGAL::Cartesian< NT>                    K;
+typedef CGAL::Point_2< K>                       Point;
+typedef CGAL::Min_ellipse_2_traits_2< K>        Traits;
+typedef CGAL::Min_ellipse_2< Traits>            Cgal_min_ellipse;
+typedef CGAL::Min_ellipse_2_rublev< Traits>     Min_ellipse;
+
+static int failures = 0;
+
+static bool
+same_result( const Min_ellipse& a, const Min_ellipse& b)
+{
+    if ( a.number_of_support_points() != b.number_of_support_points() ||
+         a.number_of_points() != b.number_of_points() ||
+         a.number_of_passes() != b.number_of_passes() ||
+         a.number_of_updates() != b.number_of_updates())
+        return( false);
+    for ( int j = 0; j < a.number_of_support_points(); ++j)
+        if ( !( a.support_point( j) == b.support_point( j)) ||
+             a.support_point_index( j) != b.support_point_index( j))
+            return( false);
+    return( std::equal( a.points_begin(), a.points_end(), b.points_begin()));
+}
+
+// the support points of either ellipse are on the boundary of the other,
+// and the support point indices refer to [ points_begin(), points_end())
+static bool
+same_ellipse( const Min_ellipse& me, const Cgal_min_ellipse& reference)
+{
+    int j;
+    for ( j = 0; j < reference.number_of_support_points(); ++j)
+        if ( !me.ellipse().has_on_boundary( reference.support_point( j)))
+            return( false);
+    for ( j = 0; j < me.number_of_support_points(); ++j)
+        if ( !reference.ellipse().has_on_boundary( me.support_point( j)) ||
+             !( me.support_point( j) == *( me.points_begin() + me.support_point_index( j))))
+            return( false);
+    return( true);
+}
+
+static void
+check( const char* name, const std::vector< Point>& input, unsigned int seed)
+{
+    const int n_modes = 9;
+    const char* modes[ n_modes] = {
+        "hull heuristic", "no heuristic", "unstable compaction", "parallel",
+        "prefilter", "hull first", "streaming permutation", "move to front",
+        "pivoting permutation" };
+    Cgal_min_ellipse reference( input.begin(), input.end());
+    std::vector< Point> points = input;
+    const Point* first = points.empty() ? 0 : &points[ 0];
+    const Point* last = first + points.size();
+
+    for ( int mode = 0; mode < n_modes; ++mode) {
+        Min_ellipse::Options options;
+        options.use_convex_hull_heuristic = mode != 1;
+        options.n_threads = 3;
+        switch ( mode) {
+          case 2: options.compaction = Min_ellipse::UNSTABLE_COMPACTION; break;
+          case 3: options.parallel = true; break;
+          case 4: options.prefilter_directions = 8; break;
+          case 5: options.hull_first = true; break;
+          case 6: options.streaming = true;
+                  options.random_permutation = true;
+                  options.random_seed = seed; break;
+          case 7: options.update_strategy = Min_ellipse::MOVE_TO_FRONT_UPDATES; break;
+          case 8: options.update_strategy = Min_ellipse::PIVOTING_UPDATES;
+                  options.random_permutation = true;
+                  options.random_seed = seed; break;
+        }
+
+        Min_ellipse copy( input.begin(), input.end(), options);
+        Min_ellipse view( first, last, Min_ellipse::View_tag(), options);
+        Min_ellipse assigned( options);
+        assigned.assign_view( first, last);
+
+        // hull first mode may keep a copy of the hull vertices, and there
+        // is nothing to refer to for no points
+        if ( ( mode != 5 && !input.empty() && !view.is_view()) ||
+             !view.is_valid() || !same_result( copy, view)) {
+            ++failures;
+            std::printf( "%s, %s: the view differs from the copy\n", name, modes[ mode]);
+        }
+        if ( !same_result( copy, assigned)) {
+            ++failures;
+            std::printf( "%s, %s: assign_view() differs from the copy\n",
+                         name, modes[ mode]);
+        }
+        if ( !same_ellipse( view, reference)) {
+            ++failures;
+            std::printf( "%s, %s: not the ellipse of CGAL::Min_ellipse_2\n",
+                         name, modes[ mode]);
+        }
+
+        Point far( 1000, 3);
+        copy.insert( far);
+        view.insert( far);
+        if ( view.is_view() || !view.is_valid() || !same_result( copy, view)) {
+            ++failures;
+            std::printf( "%s, %s: insert() into the view differs\n", name, modes[ mode]);
+        }
+    }
+    if ( !( points == input)) {
+        ++failures;
+        std::printf( "%s: the view modified the input\n", name);
+    }
+}
+
+template < class Generator >
+static void
+check_random( const char* name, int n, CGAL::Random& random, unsigned int seed)
+{
+    Generator generator( 100.0, random);
+    std::vector< Point> points;
+    for ( int i = 0; i < n; ++i, ++generator)
+        points.push_back( *generator);
+    check( name, points, seed);
+}
+
+int
+main( )
+{
+    CGAL::Random random( 19);
+
+    for ( unsigned int seed = 1; seed <= 2; ++seed) {
+        check_random< CGAL::Random_points_in_square_2< Point> >( "in square", 300, random, seed);
+        check_random< CGAL::Random_points_in_disc_2< Point> >( "in disc", 300, random, seed);
+        check_random< CGAL::Random_points_on_circle_2< Point> >( "on circle", 300, random, seed);
+        check_random< CGAL::Random_points_on_square_2< Point> >( "on square", 300, random, seed);
+    }
+
+    // a small integer grid: duplicates and many cocircular points
+    std::vector< Point> grid;
+    for ( int i = 0; i < 300; ++i)
+        grid.push_back( Point( random.get_int( 0, 12), random.get_int( 0, 9)));
+    check( "grid", grid, 3);
+
+    // tiny and empty inputs
+    for ( int n = 0; n <= 5; ++n)
+        check( "tiny", std::vector< Point>( grid.begin(), grid.begin() + n), 4);
+
+    if ( failures != 0)
+        std::printf( "%d failures\n", failures);
+    return( failures == 0 ? 0 : 1);
+}
+
+// ===== EOF =================================================================
@@ -0,0 +1,156 @@
+// Checks the warm start of Min_ellipse_2_rublev against a fresh solve: for
+// several sets of solver options, resolve() on a perturbed copy of the
+// points, resolve_view() and the hints constructor, with hints far from
+// the points, give the ellipse of CGAL::Min_ellipse_2 with support_point( i)
+// at support_point_index( i) in [ points_begin(), points_end()). Without
+// hints the result is the one of a fresh solve, and resolving the same
+// points again takes a single pass without updates.
+
+#include <CGAL/Cartesian.h>
+#include <CGAL/Gmpq.h>
+#include <CGAL/Random.h>
+#include <CGAL/point_generators_2.h>
+#include <CGAL/Min_ellipse_2.h>
+#include <CGAL/Min_ellipse_2_traits_2.h>
+#include "Min_ellipse_2_rublev.h"
+
+#include <algorithm>
+#include <vector>
+#include <cstdio>
+
+typedef CGAL::Gmpq                              NT;
+typedef CGAL::Cartesian< NT>                    K;
+typedef CGAL::Point_2< K>                       Point;
+typedef CGAL::Min_ellipse_2_traits_2< K>        Traits;
+typedef CGAL::Min_ellipse_2< Traits>            Cgal_min_ellipse;
+typedef CGAL::Min_ellipse_2_rublev< Traits>     Min_ellipse;
+
+static int failures = 0;
+
+// the support points of either ellipse are on the boundary of the other,
+// and the support point indices refer to [ points_begin(), points_end())
+static bool
+same_ellipse( const Min_ellipse& me, const Cgal_min_ellipse& reference)
+{
+    int j;
+    if ( !me.is_valid())
+        return( false);
+    for ( j = 0; j < reference.number_of_support_points(); ++j)
+        if ( !me.ellipse().has_on_boundary( reference.support_point( j)))
+            return( false);
+    for ( j = 0; j < me.number_of_support_points(); ++j)
+        if ( !reference.ellipse().has_on_boundary( me.support_point( j)) ||
+             !( me.support_point( j) == *( me.points_begin() + me.support_point_index( j))))
+            return( false);
+    return( true);
+}
+
+static bool
+same_result( const Min_ellipse& a, const Min_ellipse& b)
+{
+    if ( a.number_of_support_points() != b.number_of_support_points() ||
+         a.number_of_points() != b.number_of_points() ||
+         a.number_of_passes() != b.number_of_passes() ||
+         a.number_of_updates() != b.number_of_updates())
+        return( false);
+    for ( int j = 0; j < a.number_of_support_points(); ++j)
+        if ( !( a.support_point( j) == b.support_point( j)) ||
+             a.support_point_index( j) != b.support_point_index( j))
+            return( false);
+    return( std::equal( a.points_begin(), a.points_end(), b.points_begin()));
+}
+
+static void
+report( const char* name, const char* mode, const char* what)
+{
+    ++failures;
+    std::printf( "%s, %s: %s\n", name, mode, what);
+}
+
+static void
+check( const char* name, const std::vector< Point>& points)
+{
+    const int n_modes = 5;
+    const char* modes[ n_modes] = {
+        "hull heuristic", "parallel", "hull first", "random permutation",
+        "divide and conquer" };
+
+    // the next frame: the points scaled and shifted
+    std::vector< Point> moved;
+    for ( std::size_t i = 0; i < points.size(); ++i)
+        moved.push_back( Point( points[ i].x() * NT( 1.015625) + NT( 0.375),
+                                points[ i].y() * NT( 0.984375)));
+    Cgal_min_ellipse reference( points.begin(), points.end());
+    Cgal_min_ellipse moved_reference( moved.begin(), moved.end());
+    const Point far[ 3] = { Point( 1000, 0), Point( -1000, 5), Point( 3, 3) };
+
+    for ( int mode = 0; mode < n_modes; ++mode) {
+        Min_ellipse::Options options;
+        options.n_threads = 4;
+        options.parallel = mode == 1;
+        options.hull_first = mode == 2;
+        options.random_permutation = mode == 3;
+        options.divide_and_conquer = mode == 4;
+
+        Min_ellipse fresh( points.begin(), points.end(), options);
+        Min_ellipse me( points.begin(), points.end(), options);
+        if ( !same_ellipse( me, reference))
+            report( name, modes[ mode], "not the ellipse of CGAL::Min_ellipse_2");
+
+        me.resolve( moved.begin(), moved.end());
+        if ( !same_ellipse( me, moved_reference))
+            report( name, modes[ mode], "resolve() misses the moved ellipse");
+
+        me.resolve_view( &points[ 0], &points[ 0] + points.size(), far, far + 3);
+        if ( !same_ellipse( me, reference))
+            report( name, modes[ mode], "resolve_view() with far hints is wrong");
+
+        // the support points as hints are already the solution
+        me.resolve( points.begin(), points.end());
+        if ( !same_ellipse( me, reference) || me.number_of_passes() != 1 ||
+             me.number_of_updates() != 0)
+            report( name, modes[ mode], "resolving the same points is not settled");
+
+        Min_ellipse hinted( points.begin(), points.end(), far, far + 3, options);
+        if ( !same_ellipse( hinted, reference))
+            report( name, modes[ mode], "the far hints give a wrong ellipse");
+
+        hinted.resolve( points.begin(), points.end(), far, far);
+        if ( !same_result( hinted, fresh))
+            report( name, modes[ mode], "no hints differ from a fresh solve");
+    }
+}
+
+template < class Generator >
+static void
+check_random( const char* name, int n, CGAL::Random& random)
+{
+    Generator generator( 100.0, random);
+    std::vector< Point> points;
+    for ( int i = 0; i < n; ++i, ++generator)
+        points.push_back( *generator);
+    check( name, points);
+}
+
+int
+main( )
+{
+    CGAL::Random random( 24);
+
+    check_random< CGAL::Random_points_in_square_2< Point> >( "in square", 2000, random);
+    check_random< CGAL::Random_points_in_disc_2< Point> >( "in disc", 2000, random);
+    check_random< CGAL::Random_points_on_circle_2< Point> >( "on circle", 2000, random);
+    check_random< CGAL::Random_points_on_square_2< Point> >( "on square", 2000, random);
+
+    // a small integer grid: duplicates and many cocircular points
+    std::vector< Point> grid;
+    for ( int i = 0; i < 2000; ++i)
+        grid.push_back( Point( random.get_int( 0, 12), random.get_int( 0, 9)));
+    check( "grid", grid);
+
+    if ( failures != 0)
+        std::printf( "%d failures\n", failures);
+    return( failures == 0 ? 0 : 1);
+}
+
+// ===== EOF =================================================================
@@ -0,0 +1,145 @@
+// Checks Min_ellipse_2_rublev_window against a plain Min_ellipse_2_rublev
+// solve of the window's points after every push_back() and pop_front():
+// the window's ellipse contains every point of the window, and the
+// support points of either ellipse are on the boundary of the other. The
+// windows slide over random walks, uniform points and a small integer
+// grid with many cocircular points, with irregular extra pops, and short
+// windows over points near a flat ellipse, where an outside point must not
+// be solved with outer candidates that no longer enclose the others.
+
+#include <CGAL/Cartesian.h>
+#include <CGAL/Gmpq.h>
+#include <CGAL/Random.h>
+#include <CGAL/Min_ellipse_2_traits_2.h>
+#include "Min_ellipse_2_rublev.h"
+#include "Min_ellipse_2_rublev_window.h"
+
+#include <deque>
+#include <cmath>
+#include <cstdio>
+
+typedef CGAL::Gmpq                              NT;
+typedef CGAL::Cartesian< NT>                    K;
+typedef CGAL::Point_2< K>                       Point;
+typedef CGAL::Min_ellipse_2_traits_2< K>        Traits;
+typedef CGAL::Min_ellipse_2_rublev< Traits>     Min_ellipse;
+typedef CGAL::Min_ellipse_2_rublev_window< Traits>  Window;
+
+static int failures = 0;
+
+static void
+check( const char* name, int step, const Window& window,
+       const std::deque< Point>& points, std::size_t first_id)
+{
+    Min_ellipse me( points.begin(), points.end(), Min_ellipse::Options());
+    bool ok = window.number_of_points() == points.size();
+    std::size_t i;
+    int j;
+
+    for ( i = 0; ok && i < points.size(); ++i)
+        ok = !window.ellipse().has_on_unbounded_side( points[ i]);
+    for ( j = 0; ok && j < me.number_of_support_points(); ++j)
+        ok = window.ellipse().has_on_boundary( me.support_point( j));
+    for ( j = 0; ok && j < window.number_of_support_points(); ++j)
+        ok = me.ellipse().has_on_boundary( window.support_point( j))
+            && window.support_point_id( j) >= first_id
+            && window.support_point( j) == points[ window.support_point_id( j) - first_id];
+    if ( !ok) {
+        ++failures;
+        std::printf( "%s: step %d: the window differs from a fresh solve\n", name, step);
+    }
+}
+
+static void
+slide( const char* name, int kind, std::size_t length, int n, CGAL::Random& random)
+{
+    Window window;
+    std::deque< Point> points;
+    std::size_t first_id = 0, max_outer = 0, max_candidates = 0;
+    double x = 0, y = 0;
+
+    for ( int i = 0; i < n; ++i) {
+        if ( kind == 0) {
+            x += random.get_double( -1, 1);
+            y += random.get_double( -1, 1);
+        } else if ( kind == 1) {
+            x = random.get_double( -10, 10);
+            y = random.get_double( -10, 10);
+        } else {
+            x = std::floor( random.get_double( 0, 5));
+            y = std::floor( random.get_double( 0, 5));
+        }
+        points.push_back( Point( x, y));
+        window.push_back( points.back());
+        check( name, i, window, points, first_id);
+
+        int pops = points.size() > length ? 1 : 0;
+        if ( random.get_int( 0, 10) == 0)
+            ++pops;
+        for ( ; pops > 0 && !points.empty(); --pops) {
+            window.pop_front();
+            points.pop_front();
+            ++first_id;
+            check( name, i, window, points, first_id);
+        }
+        max_outer = (std::max)( max_outer, window.number_of_outer_candidates());
+        max_candidates = (std::max)( max_candidates, window.number_of_candidates());
+    }
+    std::printf( "%s, window %lu: %lu solves, at most %lu candidates, %lu outer\n",
+                 name, (unsigned long)length, (unsigned long)window.number_of_solves(),
+                 (unsigned long)max_candidates, (unsigned long)max_outer);
+}
+
+// a short window over points mostly near the boundary of a flat ellipse;
+// everything is drawn from CGAL::Random( seed)
+static void
+flat_ring( int seed)
+{
+    CGAL::Random random( seed);
+    Window window;
+    std::deque< Point> points;
+    std::size_t first_id = 0;
+    std::size_t length = random.get_int( 3, 10);
+    int radius = random.get_int( 2, 40);
+
+    for ( int i = 0; i < 60; ++i) {
+        double angle = random.get_double( 0, 6.283);
+        double s = random.get_double( 0, 1);
+        if ( i % 7 != 0)
+            s = 1 - s * s * s;
+        points.push_back( Point( radius * s * std::cos( angle),
+                                 s * std::sin( angle) * radius / 3));
+        window.push_back( points.back());
+        check( "flat ring", i, window, points, first_id);
+
+        int pops = points.size() > length ? 1 : 0;
+        if ( random.get_int( 0, 3) == 0)
+            ++pops;
+        for ( ; pops > 0 && !points.empty(); --pops) {
+            window.pop_front();
+            points.pop_front();
+            ++first_id;
+            check( "flat ring", i, window, points, first_id);
+        }
+    }
+}
+
+int
+main( )
+{
+    CGAL::Random random( 23);
+    const char* names[ 3] = { "random walk", "uniform", "grid" };
+
+    for ( int kind = 0; kind < 3; ++kind)
+        for ( std::size_t length = 1; length <= 64; length *= 4)
+            slide( names[ kind], kind, length, 200, random);
+    for ( int seed = 1560; seed < 1580; ++seed)
+        flat_ring( seed);
+    flat_ring( 1873);
+
+    if ( failures != 0)
+        std::printf( "%d failures\n", failures);
+    return( failures == 0 ? 0 : 1);
+}
+
+// ===== EOF =================================================================